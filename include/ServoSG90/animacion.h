@@ -0,0 +1,116 @@
+#ifndef ANIMACION_H
+#define ANIMACION_H
+
+#include "ServoSG90/servo.h"
+#include "ServoSG90/servoGroup.h"
+#include "ServoSG90/tramaTimmer.h"
+#include "ServoSG90/suavizado.h"
+#include <stddef.h>
+
+/*
+    ReproductorAnimacion: secuencias de poses en flash reproducidas desde la ISR de trama
+    -----------------------------------------------------------------------------------------------
+    Los 8 KB de SRAM no caben coreografías largas; los 256 KB de flash sí. Cada fotograma clave
+    guarda la duración del tramo, el suavizado y el ángulo de cada servo:
+
+        const S_FOTOGRAMA<3> SALUDO[] PROGMEM = {
+            //  ms    suavizado                     base hombro codo
+            {  800, E_SUAVIZADO::SUAVE,          {  90,   45,  120 } },
+            {  400, E_SUAVIZADO::LINEAL,         { 120,   45,  120 } },
+            {  400, E_SUAVIZADO::LINEAL,         {  60,   45,  120 } },
+        };
+
+    El primer fotograma parte de la consigna actual de cada servo. La tarea de trama del timer del
+    primer servo (timer maestro):
+    - Al empezar un tramo lee el fotograma de flash (pgm_read) y convierte los ángulos con la tabla
+      del servo: una sola vez por tramo.
+    - En cada trama avanza el progreso (Q16, incremento = 65536 / tramas calculado al cargar el
+      tramo; el resto de la división se acumula para que el progreso de la trama k sea exactamente
+      k · 65536 / tramas), aplica la curva (Suavizado, tabla en flash) y deja preparados los ticks de todos
+      los servos:
+
+            ticks = desde + (hasta − desde) · suavizado(progreso) >> 16
+
+    - La última trama del tramo se fija exactamente en la pose del fotograma.
+    loop() no interviene: reproducir() arranca y la animación continúa sola (o en bucle).
+*/
+
+constexpr uint8_t  MAX_SERVOS_ANIMACION = 11;     // Canales OC hardware disponibles para servo
+constexpr uint8_t  MAX_ANIMACIONES      = 2;
+
+// Fotograma clave en flash: N servos en el orden de alta del reproductor
+template <uint8_t N>
+struct S_FOTOGRAMA {
+    uint16_t duracionMs;        // Tiempo para llegar a esta pose desde la anterior
+    E_SUAVIZADO suavizado;      // Curva del tramo
+    uint8_t  angulos[N];        // Grados (0-180)
+};
+
+// Desplazamientos de los campos (iguales para cualquier N)
+constexpr uint8_t OFFSET_DURACION_FOTOGRAMA  = offsetof(S_FOTOGRAMA<1>, duracionMs);
+constexpr uint8_t OFFSET_SUAVIZADO_FOTOGRAMA = offsetof(S_FOTOGRAMA<1>, suavizado);
+constexpr uint8_t OFFSET_ANGULOS_FOTOGRAMA   = offsetof(S_FOTOGRAMA<1>, angulos);
+
+class ReproductorAnimacion {
+public :
+    S_MIEMBRO_GRUPO miembros[MAX_SERVOS_ANIMACION];
+    uint8_t  numServos = 0;
+    bool     registrado = false;                // Con hueco en la lista y tarea de trama (si no, agregar() da false)
+    uint16_t desde[MAX_SERVOS_ANIMACION];       // Ticks al inicio del tramo
+    uint16_t hasta[MAX_SERVOS_ANIMACION];       // Ticks del fotograma
+    uint16_t actuales[MAX_SERVOS_ANIMACION];    // Última consigna preparada
+
+    // Animación en flash
+    const uint8_t* fotogramas = nullptr;
+    uint16_t numFotogramas = 0;
+    uint8_t  tamanoFotograma = 0;
+    bool     bucle = false;
+
+    // Tramo en curso (solo la ISR lo modifica durante la reproducción)
+    volatile uint16_t indice = 0;
+    uint16_t tramasRestantes = 0;
+    uint32_t progreso = 0;                      // Q16
+    uint32_t incremento = 0;                    // Q16 por trama
+    uint16_t resto = 0;                         // 65536 mod tramas
+    uint16_t acumuladoResto = 0;                // Restos acumulados (< tramas)
+    uint16_t tramasTramo = 1;
+    E_SUAVIZADO suavizado = E_SUAVIZADO::LINEAL;
+    volatile bool reproduciendo = false;
+
+    E_TIMMER_ASCIOADO timmerMaestro = E_TIMMER_ASCIOADO::TIMMER0;   // Timer del primer servo
+
+    // Reproductores activos (recorridos por la ISR)
+    static ReproductorAnimacion* reproductores[MAX_ANIMACIONES];
+    static uint8_t numReproductores;
+
+public :
+    // Constructor: registra el reproductor en la lista de tareas de trama
+    ReproductorAnimacion();
+    // Metodo para añadir un servo inicializado (pasa a modo de actualizacion por trama)
+    bool agregar(ServoMotor& servo);
+    // Metodo para reproducir una animacion en flash (N debe coincidir con los servos añadidos)
+    template <uint8_t N>
+    bool reproducir(const S_FOTOGRAMA<N>* animacion, uint16_t num, bool enBucle = false) {
+        if (N != this->numServos) return false;
+        return iniciar((const uint8_t*)animacion, num, sizeof(S_FOTOGRAMA<N>), enBucle);
+    }
+    // Metodo para detener la reproduccion en la consigna actual
+    void detener();
+    // Metodo para saber si la animacion sigue reproduciendose
+    bool enReproduccion() const { return this->reproduciendo; }
+    // Metodo para leer el fotograma en curso
+    uint16_t fotogramaActual();
+
+    // Tarea de trama: avanza los reproductores del timer maestro (desde la ISR TOVn)
+    static void avanzarTrama(E_TIMMER_ASCIOADO timmer);
+
+private :
+    // Metodo para arrancar la reproduccion desde el primer fotograma
+    bool iniciar(const uint8_t* animacion, uint16_t num, uint8_t tamano, bool enBucle);
+    // Lee un fotograma de flash y prepara el tramo desde la consigna actual
+    void cargarFotograma(uint16_t k);
+    // Avanza una trama y deja preparados los OCR de todos los servos (interrupciones deshabilitadas)
+    void avanzar();
+};
+
+#endif /* ANIMACION_H */
@@ -0,0 +1,124 @@
+#ifndef ARRANQUE_H
+#define ARRANQUE_H
+
+#include <avr/eeprom.h>
+#include <util/crc16.h>
+#include "ServoSG90/timmer.h"
+#include "ServoSG90/tramaTimmer.h"
+
+/*
+    ArranqueServos: política de arranque y conexión escalonada de las salidas
+    -----------------------------------------------------------------------------------------------
+    initTimmer() cargaba OCRnx = 3000 y conectaba la salida: todos los servos saltaban al centro en
+    la primera trama y pedían la corriente de bloqueo a la vez (una fuente de 5 V barata cae y la
+    placa se reinicia). Cada ServoMotor elige ahora cómo arranca:
+
+        INMEDIATO        Pulsos desde la primera trama (comportamiento anterior).
+        SALIDA_BAJA      Pin en bajo, sin pulsos: el servo no se mueve ni consume hasta la primera
+                         escritura, que conecta la salida en la trama siguiente con la consigna ya cargada.
+        ESCALONADO       Pulsos con la salida conectada intervaloTramas después del servo anterior:
+                         los picos de arranque no coinciden.
+        ULTIMA_POSICION  (por defecto) Pulsos desde la posición guardada en EEPROM y rampa de
+                         ticksRampa por trama hasta ticksIniciales. Sin posición guardada del canal
+                         se comporta como ESCALONADO.
+
+    Posiciones guardadas: guardarPosiciones() escribe la última consigna (registroOCRData) de cada
+    servo creado. Si el servo no se movió con la placa apagada, el primer pulso coincide con su
+    posición y no hay salto. Se llama con los servos parados antes de apagar (fin de secuencia,
+    comando de parada): la EEPROM aguanta ~100 000 escrituras por celda, no se guarda en cada trama.
+
+    Imagen en EEPROM (DIRECCION_POSICIONES_EEPROM, detrás de la calibración):
+
+        firma (2) | 11 consignas en ticks (22, 0 = sin posición) | CRC16-CCITT (2)  = 26 bytes
+
+    La rampa de arranque la mueve la misma tarea de trama que las conexiones y actualiza
+    registroOCRData en cada paso. Una escritura del servo o el inicio de un movimiento de otro
+    módulo (reconectarSiPendiente) la anula: el movimiento sigue desde la consigna alcanzada.
+
+    Las conexiones pendientes se hacen desde la tarea de trama del timer de cada canal (ISR TOVn):
+    el cambio de COMnx cae justo después de BOTTOM, con el OCR de la trama ya aplicado.
+
+    Ejemplo (cuatro servos, 100 ms entre cada uno; la pinza vuelve despacio a 1200 µs):
+        ArranqueServos::configurarIntervalo(5);
+        ArranqueServos::configurarRampa(4);
+        static ServoMotor base(Pins::PWM[0], TABLA_TICKS_SG90, E_ARRANQUE_SERVO::ESCALONADO);
+        static ServoMotor pinza(Pins::PWM[1], TABLA_TICKS_SG90, E_ARRANQUE_SERVO::ULTIMA_POSICION, 2400);
+        ...
+        ArranqueServos::guardarPosiciones();      // al aparcar el brazo
+*/
+
+constexpr uint8_t MAX_CONEXIONES_PENDIENTES = 11;     // Canales OC hardware disponibles para servo
+constexpr uint8_t TRAMAS_ESCALONADO_DEFECTO = 5;      // 100 ms entre conexiones
+constexpr uint8_t TICKS_RAMPA_DEFECTO       = 8;      // 4 µs por trama (~18 °/s a 50 Hz en un SG90)
+constexpr uint16_t DIRECCION_POSICIONES_EEPROM = 0xA0;
+constexpr uint16_t FIRMA_POSICIONES            = 0x5CA0;
+
+enum class E_ARRANQUE_SERVO : uint8_t {
+    INMEDIATO       = 0,  // Salida conectada en initTimmer
+    SALIDA_BAJA     = 1,  // Sin pulsos hasta la primera escritura
+    ESCALONADO      = 2,  // Salida conectada por turnos, intervaloTramas entre canales
+    ULTIMA_POSICION = 3,  // Desde la posición guardada en EEPROM, con rampa hasta ticksIniciales
+};
+
+// Conexión de salida programada: se hace cuando tramas llega a 0
+struct S_CONEXION_PENDIENTE {
+    Timmer*  timmer;                  // nullptr = hueco libre
+    uint16_t tramas;
+};
+
+// Rampa de arranque: la consigna avanza ticksRampa por trama hasta objetivo
+struct S_RAMPA_ARRANQUE {
+    Timmer*  timmer;                  // nullptr = hueco libre
+    uint16_t objetivo;
+};
+
+struct S_POSICIONES_GUARDADAS {
+    uint16_t firma;
+    uint16_t ticks[NUM_CANALES_OC];   // 0 = canal sin posición guardada
+    uint16_t crc;
+};
+
+class ArranqueServos {
+public :
+    static S_CONEXION_PENDIENTE pendientes[MAX_CONEXIONES_PENDIENTES];
+    static uint8_t intervaloTramas;
+    static S_RAMPA_ARRANQUE rampas[MAX_CONEXIONES_PENDIENTES];
+    static uint8_t ticksRampa;
+
+public :
+    // Metodo para fijar las tramas entre dos conexiones escalonadas (antes de crear los servos)
+    static void configurarIntervalo(uint8_t tramas);
+    // Metodo para fijar el paso de la rampa de arranque en ticks por trama
+    static void configurarRampa(uint8_t ticksPorTrama);
+    // Metodo para conectar la salida de un canal dentro de n tramas (1 = siguiente trama)
+    static bool programar(Timmer& timmer, uint16_t tramas);
+    // Metodo para conectar la salida de un canal intervaloTramas después de la última pendiente
+    static bool programarEscalonado(Timmer& timmer);
+    // Metodo para anular la conexion pendiente de un canal
+    static void cancelar(Timmer& timmer);
+    // Metodo para saber si un canal tiene la conexion programada
+    static bool pendiente(const Timmer& timmer);
+    // Metodo para saber si quedan salidas por conectar
+    static bool hayPendientes();
+    // Metodo para llevar la consigna de un canal conectado hasta objetivo a ticksRampa por trama
+    static bool programarRampa(Timmer& timmer, uint16_t objetivo);
+    // Metodo para anular la rampa de un canal (la consigna queda donde llegó)
+    static void cancelarRampa(Timmer& timmer);
+    // Metodo para saber si queda alguna rampa de arranque en curso
+    static bool hayRampas();
+    // Metodo para leer la posición guardada de un pin en ticks (0 si no hay imagen válida o posición)
+    static uint16_t posicionGuardada(uint8_t pin);
+    // Metodo para guardar la consigna actual de los servos creados (solo escribe los bytes que cambian)
+    static void guardarPosiciones();
+
+    // Tarea de trama: conecta las salidas del timer cuyo turno ha llegado (desde la ISR TOVn)
+    static void avanzarTrama(E_TIMMER_ASCIOADO timmer);
+
+private :
+    // Lee la imagen de EEPROM (false si firma o CRC no cuadran)
+    static bool leerPosiciones(S_POSICIONES_GUARDADAS& imagen);
+    // CRC16-CCITT de la firma y las consignas
+    static uint16_t calcularCRC(const S_POSICIONES_GUARDADAS& imagen);
+};
+
+#endif /* ARRANQUE_H */
@@ -0,0 +1,120 @@
+#ifndef CALIBRACION_H
+#define CALIBRACION_H
+
+#include <Arduino.h>
+#include <avr/eeprom.h>
+#include <util/crc16.h>
+#include "ServoSG90/timmer.h"
+#include "ServoSG90/tablaTicks.h"
+
+/*
+    CalibracionServos: perfiles de calibración por canal guardados en EEPROM
+    -----------------------------------------------------------------------------------------------
+    Cada SG90 tiene su propio rango de pulso: con 544–2400 µs fijos unos no llegan a 0°/180° y
+    otros topan y se quedan forzando. Cada canal OC (índice en TABLA_CANALES_OC) guarda:
+
+        minUs / maxUs   Pulso a 0° y a 180°
+        trimUs          Corrección del centro (desplaza todo el rango, ±127 µs)
+        INVERTIDO       0° ↔ 180° (servo montado en espejo)
+        anguloMin/Max   Límites blandos: el servo no sale de ese intervalo por ninguna vía
+
+    Imagen en EEPROM (DIRECCION_CALIBRACION_EEPROM, fuera de la celda 0 que usa el diagnóstico):
+
+        firma (2) | version (1) | numCanales (1) | 11 perfiles × 8 | CRC16-CCITT (2)  = 94 bytes
+
+    cargar() lee la imagen con un solo eeprom_read_block (lectura secuencial, sin una llamada por
+    byte) directamente sobre la tabla en RAM y comprueba firma, versión y CRC con _crc_ccitt_update;
+    si algo no cuadra se quedan los valores por defecto (canales sin calibrar). La primera carga se
+    hace sola al registrarse el primer servo, antes de su primer pulso. guardar() usa
+    eeprom_update_block: solo se escriben las celdas que cambian.
+
+    Un servo con perfil deja la tabla en flash y convierte con la recta del perfil (ver
+    ServoMotor::aplicarCalibracion): una multiplicación 16×16 por conversión, sin división.
+
+    Calibración interactiva por puerto serie (procesarComando() desde loop(), no bloquea):
+
+        cal <pin> min <us>        Pulso a 0°     (el servo va a 0° para comprobarlo)
+        cal <pin> max <us>        Pulso a 180°   (va a 180°)
+        cal <pin> trim <us>       Trim de centro (va a 90°)
+        cal <pin> inv <0|1>       Sentido        (va a 90°)
+        cal <pin> lim <min> <max> Límites blandos en grados
+        cal <pin> borrar          Vuelve a la tabla en flash
+        cal <pin>                 Muestra el perfil
+        guardar | cargar          EEPROM
+
+    Ejemplo:
+        void loop() {
+            CalibracionServos::procesarComando(Serial);
+        }
+*/
+
+constexpr uint16_t DIRECCION_CALIBRACION_EEPROM = 0x40;
+constexpr uint16_t FIRMA_CALIBRACION            = 0x5C90;
+constexpr uint8_t  VERSION_CALIBRACION          = 1;
+constexpr uint16_t PULSO_MIN_CALIBRACION_US     = 400;    // Rango aceptado por los comandos
+constexpr uint16_t PULSO_MAX_CALIBRACION_US     = 2600;
+constexpr uint8_t  LONGITUD_COMANDO_CALIBRACION = 32;
+
+// Bits de S_CALIBRACION_SERVO::opciones
+constexpr uint8_t  CALIBRACION_ACTIVA    = 0x01;   // Perfil en uso (si no, tabla en flash del servo)
+constexpr uint8_t  CALIBRACION_INVERTIDA = 0x02;   // 0° ↔ 180°
+
+// Perfil de un canal (8 bytes)
+struct S_CALIBRACION_SERVO {
+    uint16_t minUs;         // Pulso a 0°
+    uint16_t maxUs;         // Pulso a 180°
+    int8_t   trimUs;        // Corrección del centro
+    uint8_t  opciones;      // CALIBRACION_ACTIVA | CALIBRACION_INVERTIDA
+    uint8_t  anguloMin;     // Límites blandos (grados)
+    uint8_t  anguloMax;
+};
+
+struct S_CABECERA_CALIBRACION {
+    uint16_t firma;
+    uint8_t  version;
+    uint8_t  numCanales;
+};
+
+class ServoMotor;
+
+class CalibracionServos {
+public :
+    // Perfiles en RAM, uno por canal de TABLA_CANALES_OC
+    static S_CALIBRACION_SERVO tabla[NUM_CANALES_OC];
+    // Servo creado en cada canal (para aplicar los cambios al momento)
+    static ServoMotor* servos[NUM_CANALES_OC];
+    static bool cargada;
+
+public :
+    // Metodo para leer los perfiles de EEPROM (false si no hay imagen valida: quedan los de defecto)
+    static bool cargar();
+    // Metodo para guardar los perfiles en EEPROM (solo escribe los bytes que cambian)
+    static void guardar();
+    // Metodo para dejar todos los canales sin calibrar (no toca la EEPROM)
+    static void valoresPorDefecto();
+    // Metodo para asociar un servo a su canal y aplicarle su perfil (lo llama ServoMotor)
+    static bool registrar(ServoMotor* servo);
+    // Metodo para cambiar el perfil de un canal y aplicarlo a su servo (false: no cambia nada)
+    static bool configurar(uint8_t pin, const S_CALIBRACION_SERVO& perfil);
+    // Metodo para consultar el perfil de un pin (nullptr si no tiene canal OC)
+    static const S_CALIBRACION_SERVO* perfil(uint8_t pin);
+    // Metodo para atender los comandos de calibracion que haya en el puerto (no bloquea)
+    static void procesarComando(Stream& puerto);
+    // Metodo para acumular un caracter; ejecuta el comando al llegar el fin de linea
+    static void procesarCaracter(char c, Print& salida);
+
+private :
+    static char    linea[LONGITUD_COMANDO_CALIBRACION];
+    static uint8_t longitudLinea;
+
+    // Índice del canal de un pin en TABLA_CANALES_OC (SIN_CANAL_OC si no tiene)
+    static uint8_t indiceCanal(uint8_t pin);
+    // CRC16-CCITT de la cabecera y los perfiles
+    static uint16_t calcularCRC(const S_CABECERA_CALIBRACION& cabecera);
+    // Ejecuta una línea completa
+    static void ejecutar(char* comando, Print& salida);
+    // Muestra el perfil de un pin
+    static void imprimirPerfil(uint8_t pin, Print& salida);
+};
+
+#endif /* CALIBRACION_H */
@@ -0,0 +1,135 @@
+#ifndef CINEMATICA_H
+#define CINEMATICA_H
+
+#include "ServoSG90/servo.h"
+#include "ServoSG90/servoGroup.h"
+#include "ServoSG90/trigFijo.h"
+#include "ServoSG90/cinematicaPlano.h"
+
+/*
+    CinematicaInversa: brazos SG90 de 2 y 3 grados de libertad resueltos en la placa
+    -----------------------------------------------------------------------------------------------
+    El host calculaba los ángulos y enviaba un movimientoAngulo() por articulación a 57600 baudios.
+    Con la cinemática en la placa basta con enviar el punto cartesiano (x, y, z).
+
+    Coordenadas en Q4 mm (mm × 16, int16_t, ±512 mm):
+        2 GDL: hombro + codo en el plano (x, z); y se ignora.
+        3 GDL: base (giro en z) + hombro + codo; base = atan2(y, x), r = √(x² + y²), plano (r, z).
+
+    Plano con brazo L1 y antebrazo L2 (ley del coseno, sin acos ni float; ver CinematicaPlano):
+        N = d² − L1² − L2²,  D = 2·L1·L2,  S = √(D² − N²)      (N y D reducidos a 15 bits)
+        codo   = atan2(±S, N)                                   (signo según codoArriba)
+        hombro = atan2(z, r) − atan2(L2·sen(codo), L1 + L2·cos(codo))
+
+    Alcance: |L1 − L2| ≤ d ≤ L1 + L2; fuera de él no se mueve nada (FUERA_DE_ALCANCE).
+    Cada articulación convierte su ángulo al del servo (cero, sentido) y lo limita a [min, max]
+    (LIMITADO). Las articulaciones se escriben con un ServoGroup: todas cambian en la misma trama.
+
+    Movimiento lineal: moverLineal() fija un destino y una velocidad; actualizar(), llamado desde
+    loop(), avanza el punto sobre la recta una vez por trama y resuelve la cinemática. La ISR solo
+    marca la trama nueva: los ~10000 ciclos de la resolución no bloquean la UART ni los servos de
+    8 bits. La recta parte del último punto enviado; si aún no se ha enviado ninguno (primer
+    moverLineal() tras el arranque) parte de la pose de la cinemática directa de las consignas
+    actuales de los servos (ángulo Q8 deducido de sus ticks: vale tras la rampa de arranque, una
+    escritura en µs/ticks, una animación o un coordinador):
+
+        r = L1·cos(hombro) + L2·cos(hombro + codo),  z = L1·sen(hombro) + L2·sen(hombro + codo)
+
+    Ejemplo (3 GDL):
+        static CinematicaInversa brazo(mmAQ4(80), mmAQ4(80));
+        brazo.agregarArticulacion(base,   90 << 8, false, 0, 180 << 8);
+        brazo.agregarArticulacion(hombro, 90 << 8, false, 0, 180 << 8);
+        brazo.agregarArticulacion(codo,   90 << 8, true,  0, 180 << 8);
+        brazo.moverLineal({ mmAQ4(100), 0, mmAQ4(50) }, 40);     // 40 mm/s
+        // loop(): brazo.actualizar();
+*/
+
+constexpr uint8_t  MAX_ARTICULACIONES_IK = 3;
+constexpr uint8_t  MAX_CINEMATICAS       = 2;
+constexpr int16_t  COORDENADA_MAX_IK     = 8191;  // Q4 mm (≈ 512 mm): las sumas de cuadrados caben en 32 bits
+
+// Milímetros enteros → Q4 mm
+constexpr int16_t mmAQ4(int16_t mm) { return (int16_t)(mm * 16); }
+
+enum class E_RESULTADO_IK : uint8_t {
+    OK               = 0,
+    LIMITADO         = 1,     // Alguna articulación recortada a sus límites
+    FUERA_DE_ALCANCE = 2,     // Punto no alcanzable: no se mueve
+    SIN_CONFIGURAR   = 3,     // Faltan articulaciones o longitudes
+};
+
+// Punto cartesiano en Q4 mm
+struct S_PUNTO_IK {
+    int16_t x;
+    int16_t y;
+    int16_t z;
+};
+
+// Relación entre el ángulo de la articulación y el del servo (grados Q8)
+struct S_ARTICULACION_IK {
+    ServoMotor* servo;
+    uint16_t    ceroQ8;         // Ángulo del servo con la articulación a 0°
+    bool        invertida;      // El servo gira en sentido contrario a la articulación
+    uint16_t    minQ8;          // Límites del servo
+    uint16_t    maxQ8;
+};
+
+class CinematicaInversa {
+public :
+    S_ARTICULACION_IK articulaciones[MAX_ARTICULACIONES_IK];
+    uint8_t  numArticulaciones = 0;
+    bool     registrado = false;       // Con hueco en la lista y tarea de trama (si no, agregarArticulacion() da false)
+    uint16_t longitudBrazo;            // L1, Q4 mm
+    uint16_t longitudAntebrazo;        // L2, Q4 mm
+    bool     codoArriba = true;
+    ServoGroup grupo;
+
+    // Movimiento lineal en curso
+    S_PUNTO_IK actual = { 0, 0, 0 };
+    S_PUNTO_IK inicio = { 0, 0, 0 };
+    S_PUNTO_IK destino = { 0, 0, 0 };
+    uint16_t recorridoTotal = 0;       // Q4 mm
+    uint16_t recorrido = 0;            // Q4 mm
+    uint16_t velocidad = 0;            // Q4 mm/trama
+    bool     moviendo = false;
+    bool     poseConocida = false;     // actual viene de moverA()/actualizar() (si no, cinemática directa)
+    E_RESULTADO_IK ultimoResultado = E_RESULTADO_IK::OK;
+
+    E_TIMMER_ASCIOADO timmerMaestro = E_TIMMER_ASCIOADO::TIMMER0;   // Timer de la primera articulación
+    volatile bool tramaNueva = false;
+
+    // Cinemáticas activas (marcadas por la ISR)
+    static CinematicaInversa* cinematicas[MAX_CINEMATICAS];
+    static uint8_t numCinematicas;
+
+public :
+    // Constructor: longitudes de brazo y antebrazo en Q4 mm
+    CinematicaInversa(uint16_t longitudBrazo, uint16_t longitudAntebrazo);
+    // Metodo para añadir una articulacion (2 GDL: hombro, codo | 3 GDL: base, hombro, codo)
+    bool agregarArticulacion(ServoMotor& servo, uint16_t ceroQ8, bool invertida, uint16_t minQ8, uint16_t maxQ8);
+    // Metodo para calcular los angulos de servo (grados Q8) de un punto sin mover nada
+    E_RESULTADO_IK resolver(const S_PUNTO_IK& punto, uint16_t* angulosQ8);
+    // Metodo para llevar el brazo a un punto en la siguiente trama
+    E_RESULTADO_IK moverA(const S_PUNTO_IK& punto);
+    // Metodo para recorrer la recta hasta un punto a velocidadMmS (mm/s), avanzado por actualizar()
+    E_RESULTADO_IK moverLineal(const S_PUNTO_IK& punto, uint16_t velocidadMmS);
+    // Metodo para avanzar el movimiento lineal una vez por trama (llamar desde loop)
+    void actualizar();
+    // Metodo para saber si queda recorrido del movimiento lineal
+    bool enMovimiento() const { return this->moviendo; }
+
+    // Tarea de trama: marca la trama nueva de las cinemáticas del timer (desde la ISR TOVn)
+    static void marcarTrama(E_TIMMER_ASCIOADO timmer);
+
+private :
+    // Convierte el ángulo del servo (grados Q8) al de la articulación (BAM16 con signo)
+    uint16_t servoAArticulacion(uint8_t indice, uint16_t servoQ8) const;
+    // Punto de la pose actual de los servos (cinemática directa)
+    bool cinematicaDirecta(S_PUNTO_IK& punto) const;
+    // Convierte el ángulo de la articulación al del servo y lo limita
+    bool articulacionAServo(uint8_t indice, uint16_t angulo, uint16_t& servoQ8);
+    // Escribe los ángulos de servo en todas las articulaciones (misma trama)
+    void aplicar(const uint16_t* angulosQ8);
+};
+
+#endif /* CINEMATICA_H */
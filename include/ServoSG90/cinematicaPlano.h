@@ -0,0 +1,34 @@
+#ifndef CINEMATICA_PLANO_H
+#define CINEMATICA_PLANO_H
+
+#include <Arduino.h>
+#include "ServoSG90/trigFijo.h"
+
+/*
+    CinematicaPlano: cinemática del plano (r, z) de un brazo de dos eslabones, sin servos
+    -----------------------------------------------------------------------------------------------
+    Cálculo puro de CinematicaInversa (solo TrigFijo, sin timers ni servos) para poder comprobar en
+    el PC la ida y vuelta directa → inversa (test/test_cinematica, pio test -e native).
+
+    Longitudes y coordenadas en Q4 mm; ángulos de articulación en BAM16 con signo:
+
+        inversa:  N = d² − L1² − L2²,  D = 2·L1·L2,  S = √(D² − N²)      (N y D reducidos a 15 bits)
+                  codo   = atan2(±S, N)                                   (−S con codoArriba)
+                  hombro = atan2(z, r) − atan2(L2·sen(codo), L1 + L2·cos(codo))
+        directa:  r = L1·cos(hombro) + L2·cos(hombro + codo)
+                  z = L1·sen(hombro) + L2·sen(hombro + codo)
+
+    Alcance de la inversa: |L1 − L2| ≤ d ≤ L1 + L2 (false fuera de él). L1, L2 ≤ 8191 (2^13): los
+    productos L·seno Q15 caben en 32 bits.
+*/
+
+class CinematicaPlano {
+public :
+    // Metodo para resolver hombro y codo (BAM16) del punto (r, z); false si no es alcanzable
+    static bool inversa(uint16_t l1, uint16_t l2, bool codoArriba, int16_t r, int16_t z,
+                        uint16_t& hombro, uint16_t& codo);
+    // Metodo para calcular el punto (r, z) del extremo con hombro y codo (BAM16)
+    static void directa(uint16_t l1, uint16_t l2, uint16_t hombro, uint16_t codo, int32_t& r, int32_t& z);
+};
+
+#endif /* CINEMATICA_PLANO_H */
@@ -0,0 +1,101 @@
+#ifndef COORDINADOR_H
+#define COORDINADOR_H
+
+#include "ServoSG90/servo.h"
+#include "ServoSG90/tramaTimmer.h"
+#include "ServoSG90/suavizado.h"
+
+/*
+    CoordinadorServos: movimientos multi-eje con llegada en la misma trama
+    -----------------------------------------------------------------------------------------------
+    Con un PlanificadorServo por articulación cada eje llega cuando le permiten sus límites: la
+    herramienta no sigue una recta en el espacio articular. El coordinador recibe N destinos y una
+    duración (o una velocidad máxima) y escala el tiempo de todos los ejes:
+
+        tramas     = duración / trama      (o la del eje más lento a la velocidad pedida)
+        incremento = 2^16 / tramas         progreso Q16 común a todos los ejes (el resto de la
+                                           división se acumula: progreso_k = k · 2^16 / tramas exacto)
+        ticks      = inicio + (destino − inicio) · curva(progreso) >> 16
+
+    La duración y el incremento se calculan en loop(); la tarea de trama del timer del primer eje
+    (timer maestro) avanza el progreso, aplica la curva (Suavizado: LINEAL por defecto, o una
+    tabla en flash) y deja preparados todos los OCR en la misma ISR. Con el mismo progreso todos
+    los ejes siguen la recta articular; en la última trama cada eje se fija en su destino.
+
+    Cada movimiento parte de la consigna actual del servo (registroOCRData), aunque la haya escrito
+    otro módulo después del anterior; la tarea la actualiza en cada trama.
+
+    Los ejes pasan a modo de actualización por trama. Un eje no debe tener además un
+    PlanificadorServo en movimiento (ambos escribirían su OCR).
+
+    Ejemplo:
+        static CoordinadorServos brazo;
+        brazo.agregar(hombro);
+        brazo.agregar(codo);
+        uint8_t pose[] = { 45, 120 };
+        brazo.moverAngulos(pose, 2, 1500);        // Ambos llegan a los 1.5 s
+        brazo.moverAngulos(pose, 2, 1500, E_SUAVIZADO::SENO);
+*/
+
+constexpr uint8_t  MAX_EJES_COORDINADOS = 11;     // Canales OC hardware disponibles para servo
+constexpr uint8_t  MAX_COORDINADORES    = 4;
+
+// Estado de cada eje: canal de trama precalculado e inicio/destino del movimiento
+struct S_EJE_COORDINADO {
+    ServoMotor*     servo;
+    S_TRAMA_TIMMER* trama;      // Estado de trama del timer del servo
+    uint8_t         bitCanal;   // Bit del canal (A/B/C) en trama->pendientes
+    uint8_t         indice;     // Índice del canal en trama->ticks
+    uint16_t        inicio;     // Ticks
+    uint16_t        destino;    // Ticks
+    uint16_t        actual;     // Última consigna preparada
+};
+
+class CoordinadorServos {
+public :
+    S_EJE_COORDINADO ejes[MAX_EJES_COORDINADOS];
+    uint8_t numEjes = 0;
+    bool    registrado = false;             // Con hueco en la lista y tarea de trama (si no, agregar() da false)
+    E_TIMMER_ASCIOADO timmerMaestro = E_TIMMER_ASCIOADO::TIMMER0;   // Timer del primer eje (TIMMER0 = sin ejes)
+    volatile uint16_t tramasRestantes = 0;
+    uint32_t progreso = 0;                  // Q16
+    uint32_t incremento = 0;                // Q16 por trama
+    uint16_t resto = 0;                     // 2^16 mod tramas
+    uint16_t acumuladoResto = 0;            // Restos acumulados (< tramas)
+    uint16_t tramasTotales = 1;
+    E_SUAVIZADO curva = E_SUAVIZADO::LINEAL;
+
+    // Coordinadores activos (recorridos por la ISR)
+    static CoordinadorServos* coordinadores[MAX_COORDINADORES];
+    static uint8_t numCoordinadores;
+
+public :
+    // Constructor: registra el coordinador en la lista de tareas de trama
+    CoordinadorServos();
+    // Metodo para añadir un eje inicializado (pasa a modo de actualizacion por trama)
+    bool agregar(ServoMotor& servo);
+    // Metodo para mover todos los ejes a ticks (uno por eje, en orden de alta) en duracionMs
+    bool moverTicks(const uint16_t* ticks, uint8_t n, uint16_t duracionMs,
+                    E_SUAVIZADO curva = E_SUAVIZADO::LINEAL);
+    // Metodo para mover todos los ejes a angulos (uno por eje, en orden de alta) en duracionMs
+    bool moverAngulos(const uint8_t* angulos, uint8_t n, uint16_t duracionMs,
+                      E_SUAVIZADO curva = E_SUAVIZADO::LINEAL);
+    // Metodo para mover a angulos con el eje de mayor recorrido a velocidadGradosS (°/s, media)
+    bool moverAngulosVelocidad(const uint8_t* angulos, uint8_t n, uint16_t velocidadGradosS,
+                               E_SUAVIZADO curva = E_SUAVIZADO::LINEAL);
+    // Metodo para saber si queda alguna trama del movimiento
+    bool enMovimiento();
+    // Metodo para detener el movimiento en la consigna actual
+    void detener();
+
+    // Tarea de trama: avanza los coordinadores del timer maestro (desde la ISR TOVn)
+    static void avanzarTrama(E_TIMMER_ASCIOADO timmer);
+
+private :
+    // Metodo para planificar el movimiento en un numero de tramas dado
+    void planificar(const uint16_t* ticks, uint8_t n, uint16_t tramas, E_SUAVIZADO curva);
+    // Avanza una trama y deja preparados los OCR de todos los ejes (interrupciones deshabilitadas)
+    void avanzar();
+};
+
+#endif /* COORDINADOR_H */
@@ -0,0 +1,66 @@
+#ifndef GESTOR_TIMMERS_H
+#define GESTOR_TIMMERS_H
+
+#include "ServoSG90/timmer.h"
+#include "ServoSG90/tramaTimmer.h"
+
+/*
+    GestorTimmers: registro de propiedad de los timers hardware
+    -----------------------------------------------------------------------------------------------
+    Cada motor (Timmer, ServoMotorPin, ServoMultiplex, ServoMotor8Bits) reserva su canal antes de
+    tocar registros del timer:
+
+        CONFIGURAR  → primer dueño del timer: debe configurar WGM, prescaler y TOP.
+        COMPARTIDO  → el timer ya está en el mismo modo con el mismo TOP (y prescaler, si el
+                      solicitante lo indica): solo se configura el canal
+                      (COMnx, OCRnx). Evita que una segunda instancia reinicie el timer.
+        CONFLICTO   → modo o TOP distinto, o canal ya ocupado: la reserva se rechaza.
+
+    Timer0 queda registrado desde el arranque como CORE_MILLIS (millis/delay del core). Solo se
+    aceptan reservas que mantienen ese modo (comparaciones OCR0A/OCR0B de ServoMotor8Bits); un
+    servo de 16 bits o un cambio de modo en Timer0 se rechaza.
+
+    imprimirResumen() muestra el dueño de cada canal.
+*/
+
+enum class E_MODO_TIMMER : uint8_t {
+    LIBRE        = 0,     // Sin dueño
+    CORE_MILLIS  = 1,     // Timer0 del core: Fast PWM 8 bits, clk/64, TIMER0_OVF_vect (intocable)
+    FAST_PWM_ICR = 2,     // Fast PWM con TOP = ICRn (servos hardware)
+    CTC_ICR      = 3,     // CTC con TOP = ICRn (ServoMultiplex)
+    NORMAL_8BITS = 4,     // Modo Normal de 8 bits (ServoMotor8Bits en Timer2)
+    PWM_RAPIDO   = 5,     // Fast PWM con TOP = ICRn de uso general (Timmer::iniciarPWM)
+    PWM_FASE     = 6,     // Phase Correct PWM con TOP = ICRn de uso general (Timmer::iniciarPWM)
+};
+
+enum class E_RESERVA_TIMMER : uint8_t {
+    CONFIGURAR = 0,       // Timer libre: el solicitante lo configura
+    COMPARTIDO = 1,       // Timer ya configurado de forma compatible
+    CONFLICTO  = 2,       // Reserva rechazada
+};
+
+// Estado de un timer: modo, TOP y dueño de cada canal (A, B, C)
+struct S_RECURSO_TIMMER {
+    E_MODO_TIMMER modo;
+    uint16_t      top;
+    uint8_t       bitsCS;     // Prescaler (CSn2:0) registrado; 0 = no indicado
+    const char*   duenos[NUM_CANALES_TIMMER];
+};
+
+class GestorTimmers {
+public :
+    // Metodo para reservar un canal de un timer en un modo, TOP y prescaler determinados
+    static E_RESERVA_TIMMER reservar(E_TIMMER_ASCIOADO timmer, E_MODO_TIMMER modo, uint16_t top,
+                                     uint8_t canal, const char* dueno, uint8_t bitsCS = 0);
+    // Metodo para liberar un canal (el timer queda libre cuando no le quedan canales)
+    static void liberar(E_TIMMER_ASCIOADO timmer, uint8_t canal);
+    // Metodo para consultar el modo registrado de un timer
+    static E_MODO_TIMMER modo(E_TIMMER_ASCIOADO timmer);
+    // Metodo para imprimir la tabla de dueños de timers y canales
+    static void imprimirResumen();
+
+private :
+    static S_RECURSO_TIMMER recursos[NUM_TIMMERS];
+};
+
+#endif /* GESTOR_TIMMERS_H */
@@ -0,0 +1,209 @@
+#ifndef PLANIFICADOR_H
+#define PLANIFICADOR_H
+
+#include "ServoSG90/servo.h"
+#include "ServoSG90/tramaTimmer.h"
+
+/*
+    PlanificadorServo: perfil de velocidad trapezoidal avanzado en la ISR de trama
+    -----------------------------------------------------------------------------------------------
+    movimientoAngulo() salta el OCR directamente al destino: el servo gira a máxima velocidad y
+    pide el pico de corriente. El planificador limita velocidad y aceleración; loop() solo publica
+    destinos (moverA) y la ISR TOVn del timer del servo avanza la consigna una vez por trama.
+
+    Unidades internas (punto fijo, sin float en la ISR):
+        posicion      Q8 ticks            (ticks × 256)
+        velocidad     Q8 ticks/trama      (|v| ≤ velocidadMax ≤ 0xFFFF)
+        aceleracion   Q8 ticks/trama²
+
+    En cada trama se elige la mayor velocidad de { v + a (limitada a vMax), v, v − a } que aún
+    permite frenar antes del destino:
+
+        frenado(v) = Σ (v − k·a), k = 1..q, q = v / a   →   q·v − a·q·(q + 1) / 2
+
+    Si la velocidad elegida alcanza el destino, la posición se fija en él y la velocidad a 0.
+    Un destino nuevo a mitad de movimiento se acepta sin parar: si el servo se aleja, primero frena.
+    Parado, cada destino parte de la consigna del servo (registroOCRData, que la tarea también
+    actualiza): tras una escritura directa o la rampa de arranque no hay salto.
+    Coste: hasta tres evaluaciones de frenado (una división de 16 bits cada una) por servo y trama.
+
+    Ejemplo:
+        static ServoMotor hombro(Pins::PWM[0]);
+        static PlanificadorServo planHombro(hombro);
+        planHombro.configurarLimites(200, 800);   // 200 °/s, 800 °/s²
+        planHombro.moverA(150);
+
+    Perfil en S (CURVA_S): 7 segmentos con jerk limitado para brazos con carga
+    -----------------------------------------------------------------------------------------------
+        jerk:   +J | 0 | −J | 0 | −J | 0 | +J
+        tramas: Tj | Ta| Tj | Tv| Tj | Ta| Tj
+
+    Con jerk unitario (±1 por trama) el recorrido tiene forma cerrada:
+
+        Vu = Tj·(Tj + Ta)                 velocidad de crucero
+        Su = Vu·(2·Tj + Ta + Tv)          recorrido total
+
+    moverATicks() elige Tj, Ta, Tv desde los límites de jerk, aceleración y velocidad (recortando
+    Ta y después Tj en recorridos cortos) y guarda la escala K = D·2^(s+r) / Su. Esto se calcula
+    una vez por movimiento, en loop() (con 64 bits). La ISR solo integra enteros (a += ±1, v += a,
+    p += v) y escala con 32 bits:
+
+        posicion = inicio ± ((p >> r)·K + ((p mod 2^r)·K >> r)) >> s
+
+    r deja Su >> r en 16 bits y s deja D·256·2^s < 2^31: los dos productos de 32 bits no
+    desbordan y K conserva al menos 14 bits (error sistemático < 0.01 % del recorrido).
+
+    Tj y Ta se redondean hacia abajo y Tv hacia arriba: el jerk real D/Su nunca supera el límite y
+    la última trama cae exactamente en el destino. Tj y Ta se limitan a MAX_TJ/MAX_TA_CURVA_S
+    tramas (solo bajan la aceleración y la velocidad de crucero); Tv no se limita: si el movimiento
+    no cabe en MAX_TRAMAS_CURVA_S tramas con esos límites, moverATicks() devuelve false y no se
+    mueve (nunca se acelera por encima de lo configurado). Un destino nuevo a mitad de una curva se planifica
+    desde el destino en curso y arranca al terminar ésta (sin saltos de aceleración).
+
+        planHombro.configurarJerk(4000);                          // 4000 °/s³
+        planHombro.configurarPerfil(E_PERFIL_MOVIMIENTO::CURVA_S);
+        planHombro.moverA(30);
+
+    Cola de segmentos con anticipación (perfil TRAPECIO)
+    -----------------------------------------------------------------------------------------------
+    moverA() sustituye el destino; encolar() lo añade a un anillo de CAPACIDAD_COLA_MOVIMIENTOS
+    segmentos (destino + velocidad máxima propia) que la ISR recorre sin esperar a loop(). El host
+    puede enviar varios puntos por adelantado y seguir mientras espacioCola() > 0.
+
+    Cada segmento guarda su velocidad de salida: la mayor con la que puede terminar y aún frenar
+    en los siguientes. Al encolar, loop() la recalcula de atrás hacia delante:
+
+        salida[n − 1] = 0
+        salida[i]     = min(vMax[i], vMax[i + 1], v)   con   v² + a·v = vs² − a·vs + 2·a·L[i + 1]
+                        (vs = salida[i + 1]; 0 si el segmento i + 1 invierte el sentido o mide 0)
+
+    El término a·v deja una trama de margen: el cruce cae a mitad de trama y la frenada del
+    segmento siguiente empieza hasta una trama tarde.
+
+    El recorrido se detiene en cuanto un valor no cambia. La ISR usa la salida del segmento en
+    curso en la condición de frenado (dist − v + frenado(salida) ≥ frenado(v)) y, al cruzar su
+    destino con salida > 0, pasa al siguiente conservando posición y velocidad: los segmentos
+    en el mismo sentido se encadenan sin parar.
+
+        planHombro.encolar(60, 120);      // 120 °/s en este tramo
+        planHombro.encolar(90);           // velocidad de configurarLimites()
+        planHombro.encolar(150);
+*/
+
+constexpr uint8_t  MAX_PLANIFICADORES   = 11;     // Uno por canal OC hardware
+constexpr uint8_t  SEGMENTOS_CURVA_S    = 7;
+constexpr uint16_t MAX_TJ_CURVA_S       = 250;    // Tramas por segmento de jerk (5 s)
+constexpr uint16_t MAX_TA_CURVA_S       = 500;    // Tramas a aceleración constante (10 s)
+constexpr uint16_t MAX_TRAMAS_CURVA_S   = 0xFFFF; // Duración máxima (límites de 16 bits: 21 min a 50 Hz)
+constexpr uint8_t  CAPACIDAD_COLA_MOVIMIENTOS = 8;   // Segmentos por planificador (potencia de 2)
+constexpr uint8_t  MASCARA_COLA_MOVIMIENTOS   = CAPACIDAD_COLA_MOVIMIENTOS - 1;
+static_assert((CAPACIDAD_COLA_MOVIMIENTOS & MASCARA_COLA_MOVIMIENTOS) == 0, "La cola debe ser potencia de 2");
+
+enum class E_PERFIL_MOVIMIENTO : uint8_t {
+    TRAPECIO = 0,     // Velocidad y aceleración limitadas (por defecto)
+    CURVA_S  = 1,     // 7 segmentos con jerk limitado
+};
+
+// Plan de una curva S: límites de segmento y escala, calculados una vez por movimiento
+struct S_PLAN_CURVA_S {
+    uint16_t limites[SEGMENTOS_CURVA_S];  // Última trama (acumulada) de cada segmento
+    uint32_t escala;                      // K: Q8 ticks por unidad de recorrido, << desplazamiento
+    uint8_t  desplazamiento;              // s
+    uint8_t  reduccion;                   // r: el recorrido unitario se divide por 2^r antes de escalar
+    uint16_t inicio;                      // Ticks
+    uint16_t destino;                     // Ticks
+};
+
+// Segmento encolado: velocidades en Q8 ticks/trama
+struct S_SEGMENTO_MOVIMIENTO {
+    uint16_t destino;                     // Ticks
+    uint16_t velocidadMax;                // Límite propio del segmento
+    uint16_t velocidadSalida;             // Velocidad al cruzar el destino (anticipación)
+};
+
+class PlanificadorServo {
+public :
+    ServoMotor*        servo;
+    const S_CANAL_OC*  canal;                 // Canal del servo (timer que avanza el plan)
+    bool               registrado = false;    // Con hueco en la lista y tarea de trama (si no, moverA() da false)
+
+    volatile int32_t   posicion = 0;          // Q8 ticks
+    volatile int32_t   velocidad = 0;         // Q8 ticks/trama, con signo
+    volatile uint16_t  objetivo = 0;          // Ticks
+    uint16_t           velocidadMax = 0xFFFF; // Q8 ticks/trama
+    uint16_t           aceleracionMax = 0xFFFF;   // Q8 ticks/trama²
+    uint32_t           jerkMax = 0xFFFFFF;    // Q16 ticks/trama³
+    E_PERFIL_MOVIMIENTO perfil = E_PERFIL_MOVIMIENTO::TRAPECIO;
+
+    // Curva S: plan en curso y plan pendiente (doble buffer) y estado de la integración unitaria
+    S_PLAN_CURVA_S     planes[2];
+    volatile uint8_t   planActivo = 0;
+    volatile bool      curvaActiva = false;
+    volatile bool      curvaPendiente = false;
+    uint16_t           trama = 0;
+    uint8_t            segmento = 0;
+    int16_t            acelUnitaria = 0;
+    int32_t            velUnitaria = 0;
+    uint32_t           recorridoUnitario = 0;
+
+    // Cola de segmentos (la ISR consume por la cabeza, loop() añade por la cola)
+    S_SEGMENTO_MOVIMIENTO cola[CAPACIDAD_COLA_MOVIMIENTOS];
+    volatile uint8_t   cabeza = 0;
+    volatile uint8_t   numSegmentos = 0;
+
+    // Planificadores activos (recorridos por la ISR)
+    static PlanificadorServo* planificadores[MAX_PLANIFICADORES];
+    static uint8_t numPlanificadores;
+
+public :
+    // Constructor: registra el planificador en la trama del timer del servo
+    PlanificadorServo(ServoMotor& servo);
+    // Metodo para fijar velocidad (°/s) y aceleración (°/s²) máximas
+    void configurarLimites(uint16_t velocidadGradosS, uint16_t aceleracionGradosS2);
+    // Metodo para fijar el jerk máximo (°/s³) de la curva S
+    void configurarJerk(uint16_t jerkGradosS3);
+    // Metodo para elegir el perfil de movimiento (solo con el servo parado)
+    bool configurarPerfil(E_PERFIL_MOVIMIENTO perfil);
+    // Metodo para publicar un destino en grados (0-180)
+    bool moverA(uint8_t angulo);
+    // Metodo para publicar un destino en ticks de 0.5 µs (limitado al rango del servo; false si una
+    // curva S no cabe en MAX_TRAMAS_CURVA_S con los limites configurados)
+    bool moverATicks(uint16_t ticks);
+    // Metodo para encolar un destino en grados (0-180) a velocidadGradosS (0 = límite general)
+    bool encolar(uint8_t angulo, uint16_t velocidadGradosS = 0);
+    // Metodo para encolar un destino en ticks de 0.5 µs (false si la cola está llena o el perfil es CURVA_S)
+    bool encolarTicks(uint16_t ticks, uint16_t velocidadGradosS = 0);
+    // Metodo para leer los segmentos libres de la cola
+    uint8_t espacioCola();
+    // Metodo para vaciar la cola (el servo frena en el destino del segmento en curso)
+    void vaciarCola();
+    // Metodo para saber si el servo sigue en movimiento
+    bool enMovimiento();
+    // Metodo para leer la consigna actual en ticks
+    uint16_t posicionTicks();
+
+    // Tarea de trama: avanza los planificadores del timer (desde la ISR TOVn)
+    static void avanzarTrama(E_TIMMER_ASCIOADO timmer);
+
+private :
+    // Avanza una trama y devuelve los ticks de la nueva consigna (0 si el servo está parado en destino)
+    uint16_t avanzar();
+    // Parado: parte de la consigna actual del servo si otro escritor la cambió
+    void sincronizarConsigna();
+    // Pasa al siguiente segmento de la cola (desde la ISR)
+    void siguienteSegmento();
+    // Distancia (Q8) que se recorre frenando desde v hasta 0
+    static uint32_t distanciaFrenado(uint16_t v, uint16_t a);
+    // Convierte °/s a Q8 ticks/trama con la pendiente del servo
+    uint32_t velocidadATramas(uint16_t velocidadGradosS);
+    // Recalcula de atrás hacia delante la velocidad de salida de los segmentos encolados
+    void anticipar();
+    // Planifica una curva S hasta destino (en loop) y la arranca o la deja pendiente
+    bool planificarCurvaS(uint16_t destino);
+    // Calcula límites de segmento y escala de una curva S entre inicio y destino (false si no cabe)
+    bool calcularCurvaS(S_PLAN_CURVA_S& plan, uint16_t inicio, uint16_t destino);
+    // Avanza una trama de la curva S y devuelve los ticks de la consigna (0 si no hay curva)
+    uint16_t avanzarCurvaS();
+};
+
+#endif /* PLANIFICADOR_H */
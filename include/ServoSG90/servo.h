@@ -4,12 +4,30 @@
 #include "System/pinout/pinout.h"
 #include "System/msg/msg.h"
 #include "ServoSG90/timmer.h"
+#include "ServoSG90/tablaTicks.h"
+#include "ServoSG90/tramaTimmer.h"
+#include "ServoSG90/arranque.h"
+#include "ServoSG90/calibracion.h"
 #include "System/msg/msg.h"
 
 
 #define DEBUG_SERVO_SG90  1
 
-constexpr int PINES_VALIDOS_SERVO[] = { 2, 3, 5, 6, 7, 10, 11, 12 };
+constexpr int PINES_VALIDOS_SERVO[] = { 2, 3, 5, 6, 7, 8, 11, 12, 44, 45, 46 };
+constexpr uint8_t MAX_SERVOS_REPOSO = 11;    // Servos con liberación automática (canales OC hardware)
+
+/*
+    Desconexión y reposo
+    -----------------------------------------------------------------------------------------------
+    desconectar() pone COMnx1:COMnx0 = 00: el pin queda en bajo, el servo deja de recibir pulsos y
+    de hacer par (un SG90 parado en carga consume la mayor parte del presupuesto de potencia). La
+    consigna se sigue guardando en el OCR; conectar() reanuda los pulsos en la siguiente trama.
+
+    configurarReposo(n): la tarea de trama del timer compara el OCR del canal (y su valor pendiente
+    de trama) con el de la trama anterior. Tras n tramas sin cambio libera la salida; el primer
+    cambio de consigna la vuelve a conectar, sea cual sea el escritor (escritura directa, grupo,
+    planificador o animación). Una desconexión manual no se reconecta sola.
+*/
 
 class ServoMotor {
 
@@ -30,19 +48,100 @@ public :
 
     //Timmer asociado al servo
     Timmer timmerServo;
+
+    //Tabla ángulo → ticks en flash (rango de pulso del servo)
+    const S_TABLA_TICKS* tablaTicks;
+    //Límites del pulso en ticks (entradas 0° y 180° de la tabla, o límites blandos del perfil)
+    uint16_t ticksMin = 0;
+    uint16_t ticksMax = 0;
+    //Pendiente en ticks por grado (Q8): convierte °/s y °/s² del planificador y del coordinador
+    uint16_t ticksPorGradoQ8 = 0;
+
+    //Perfil de calibración (CalibracionServos): recta en RAM en lugar de la tabla en flash
+    bool     calibrado = false;
+    bool     invertido = false;
+    uint16_t ticksCero = 0;            // Pulso a 0° con el trim (a 180° si está invertido)
+    uint8_t  anguloMin = 0;            // Límites blandos (grados)
+    uint8_t  anguloMax = ANGULO_MAX_SERVO;
+
+    //Modo de actualización del OCR (directo atómico o confirmado al inicio de trama)
+    E_MODO_ACTUALIZACION modoActualizacion = E_MODO_ACTUALIZACION::DIRECTO;
+    //Dithering temporal: las consignas con fracción de tick alternan el OCR entre tramas (ver TramaTimmer)
+    bool dithering = false;
+
+    //Política de arranque de la salida (ver ArranqueServos)
+    E_ARRANQUE_SERVO arranque = E_ARRANQUE_SERVO::ULTIMA_POSICION;
+    //La siguiente escritura reconecta la salida (SALIDA_BAJA sin escribir o liberada por reposo)
+    volatile bool reconectarAlEscribir = false;
+
+    //Reposo: tramas sin cambio de consigna antes de liberar la salida (0 = nunca)
+    uint16_t tramasReposo = 0;
+    uint16_t tramasSinCambio = 0;
+    uint16_t ultimoOCR = 0;
+
+    // Servos con reposo configurado (recorridos por la ISR)
+    static ServoMotor* servosReposo[MAX_SERVOS_REPOSO];
+    static uint8_t numServosReposo;
 public :
-    // Constructor
-    ServoMotor(const PinInfo& pin);
+    // Constructor: consigna inicial en ticks y política de arranque (por defecto, rampa desde la posición guardada)
+    ServoMotor(const PinInfo& pin, const S_TABLA_TICKS* tabla = TABLA_TICKS_SG90,
+               E_ARRANQUE_SERVO arranque = E_ARRANQUE_SERVO::ULTIMA_POSICION, uint16_t ticksIniciales = TICKS_PULSO_INICIAL);
     // Metodo para visualizar el estado del pinout del servo
     void printServoPinOut(const PinInfo& pin);
     // Metodo para mover el servo a un angulo especifico
     bool movimientoAngulo(uint8_t angulo);
+    // Metodo para mover el servo a un angulo con fraccion (Q8: grados × 256, interpolado)
+    bool movimientoAnguloQ8(uint16_t anguloQ8);
+    // Metodo para mover el servo en centesimas de grado (0-18000, interpolado)
+    bool movimientoCentigrados(uint16_t centigrados);
+    // Metodo para escribir el pulso en microsegundos (limitado al rango del servo)
+    bool escribirMicrosegundos(uint16_t us);
+    // Metodo para escribir el pulso en ticks de 0.5 µs (limitado al rango del servo, sin conversion)
+    bool escribirTicks(uint16_t ticks);
+    // Metodo para convertir un angulo (0-180) a ticks con el perfil o la tabla del servo
+    uint16_t ticksDeAngulo(uint8_t angulo) const;
+    // Metodo para convertir un angulo Q8 (grados × 256) a ticks con el perfil o la tabla del servo
+    uint16_t ticksDeAnguloQ8(uint16_t anguloQ8) const;
+    // Metodo para convertir ticks a angulo Q8 (inversa de ticksDeAnguloQ8 con la recta del servo)
+    uint16_t anguloQ8DeTicks(uint16_t ticks) const;
+    // Metodo para leer el angulo Q8 de la consigna actual (registroOCRData, la escriba quien la escriba)
+    uint16_t anguloQ8Actual() const;
+    // Metodo para usar un perfil de calibracion (sin CALIBRACION_ACTIVA vuelve a la tabla en flash)
+    bool aplicarCalibracion(const S_CALIBRACION_SERVO& perfil);
+    // Metodo para escribir el pulso en ticks Q8 (ticks × 256); la fraccion solo llega al OCR con dithering
+    bool escribirTicksQ8(uint32_t ticksQ8);
+    // Metodo para activar o quitar el dithering temporal (lo activa en modo de actualizacion por trama)
+    bool configurarDithering(bool activo);
+    // Metodo para convertir un angulo Q8 a ticks Q8 (ticks × 256) con el perfil o la tabla del servo
+    uint32_t ticksQ8DeAnguloQ8(uint16_t anguloQ8) const;
+    // Metodo para conectar la salida en la siguiente trama si sigue en bajo (no adelanta un turno escalonado)
+    bool conectar();
+    // Metodo para empezar un movimiento de otro modulo: anula la rampa de arranque y conecta la salida
+    // solo si espera a la siguiente escritura (no deshace desconectar())
+    bool reconectarSiPendiente();
+    // Metodo para quitar los pulsos (el pin queda en bajo) hasta el siguiente conectar()
+    void desconectar();
+    // Metodo para saber si el servo recibe pulsos
+    bool conectado() const { return this->timmerServo.salidaConectada; }
+    // Metodo para liberar la salida tras n tramas sin cambio de consigna (0 = nunca)
+    bool configurarReposo(uint16_t tramas);
+    // Metodo para seleccionar como se actualiza el OCR (directo o por trama)
+    void configurarModoActualizacion(E_MODO_ACTUALIZACION modo);
     // Metodo para verificar si el pin es compatible con servo
     bool pinesNoDisponibles(const PinInfo& pin);
     // Metodo para imprimir mensaje de pin no disponible
     void printNopinDisponibleParaServo(const PinInfo& pin);
     // Metodo para imprimir texto con formato fijo
     void printFijo(const char* text, uint8_t width); 
+
+    // Tarea de trama: libera o reconecta los servos en reposo del timer (desde la ISR TOVn)
+    static void vigilarReposo(E_TIMMER_ASCIOADO timmer);
+
+private :
+    // Metodo para llevar los ticks (y su fraccion Q8, con dithering) al OCR segun el modo de actualizacion
+    void aplicarTicks(uint16_t ticks, uint8_t fraccion = 0);
+    // Metodo para dejar el canal en un valor fijo sin esperar a la siguiente consigna
+    void detenerDithering();
 };
 
 #endif /* Servo.h */
\ No newline at end of file
@@ -0,0 +1,114 @@
+#ifndef SERVO_8BITS_H
+#define SERVO_8BITS_H
+
+#include "System/pinout/pinout.h"
+#include "ServoSG90/timmer.h"
+#include "ServoSG90/tablaTicks.h"
+#include <util/atomic.h>
+
+/*
+    ServoMotor8Bits: servos en los pines de Timer0 (4, 13) y Timer2 (9, 10)
+    -----------------------------------------------------------------------------------------------
+    Un OCR de 8 bits no puede guardar los 1088–4800 ticks de un pulso de servo. El pulso se genera
+    contando ciclos completos del timer (256 ticks) y terminando con una comparación en el resto:
+
+        pulso = ciclosFin × 256 + restoFin
+
+        ciclo 0: subida del pin ── ciclos 1..n ── ciclo ciclosFin: OCRnx = restoFin → bajada
+
+    Timer2 (pines 9, 10) — el motor es dueño del timer:
+    - Modo Normal, prescaler 8 → tick 0.5 µs (mismos ticks que los servos de 16 bits).
+    - TIMER2_OVF_vect cuenta ciclos (128 µs); trama = 156 ciclos = 19.968 ms.
+    - La subida ocurre en la ISR de desbordamiento; se lee TCNT2 tras subir el pin y se suma al
+      fin del pulso, así la latencia de entrada no acorta el pulso.
+    - La bajada la hace TIMER2_COMPA/COMPB_vect. Si el resto es menor que MARGEN_TIMER2_TICKS la
+      ISR de desbordamiento espera a TCNT2 y baja el pin (no se pierde la comparación). Si la ISR
+      de desbordamiento llega tan tarde que TCNT2 ya pasó el resto (otra ISR la retrasó), baja el
+      pin en el momento en lugar de esperar a la comparación del ciclo siguiente.
+    - Resolución: 0.5 µs. Coste: ~7800 ISR/s de desbordamiento (≈ 2–3 % de CPU).
+
+    Timer0 (pines 4, 13) — el timer sigue siendo del core (millis/delay):
+    - No se cambia el modo ni el prescaler (Fast PWM, clk/64 → tick 4 µs, ciclo 1.024 ms) ni se
+      usa TIMER0_OVF_vect. Cada canal usa su propia comparación (TIMER0_COMPA/COMPB_vect) como
+      contador de ciclos; trama = 20 ciclos = 20.48 ms.
+    - OCR0x tiene doble buffer en Fast PWM: cada ISR programa la comparación del ciclo siguiente.
+      La subida se hace en OCR0x = 64 o 192, elegido por trama para que la bajada caiga en un ciclo
+      posterior y a más de MARGEN_TIMER0_TICKS de BOTTOM (lejos de la ISR de millis y de la carga
+      del buffer).
+    - Resolución: 4 µs (≈ 0.4° en un SG90). Coste: 1000 ISR/s por canal (< 1 % de CPU).
+
+    Las salidas OCnx quedan desconectadas (COMnx = 00): analogWrite() deja de funcionar en esos
+    pines. Los pulsos se indican en ticks de 0.5 µs en ambos timers.
+*/
+
+constexpr uint8_t  NUM_CANALES_8BITS       = 4;
+constexpr uint8_t  CICLOS_TRAMA_TIMER2     = 156;     // 156 × 128 µs = 19.968 ms
+constexpr uint8_t  CICLOS_TRAMA_TIMER0     = 20;      // 20 × 1.024 ms = 20.48 ms
+constexpr uint8_t  INICIO_TIMER0           = 64;      // Comparación de subida en Timer0 (o 64 + 128)
+constexpr uint8_t  MARGEN_TIMER0_TICKS     = 32;      // 128 µs: distancia mínima de la bajada a BOTTOM
+constexpr uint8_t  MARGEN_TIMER2_TICKS     = 24;      // 12 µs: restos menores se bajan en la ISR de desbordamiento
+constexpr uint8_t  DESPLAZAMIENTO_TIMER0   = 3;       // Tick Timer0 (4 µs) = 8 ticks de 0.5 µs
+constexpr uint8_t  SIN_CANAL_8BITS         = 0xFF;
+
+// Descriptor de canal OC de 8 bits (en flash)
+struct S_CANAL_8BITS {
+    uint8_t             pin;            // Pin Arduino
+    E_CANAL_OC          canalOC;        // Canal Output Compare
+    E_TIMMER_ASCIOADO   timmer;         // Timer asociado (TIMMER0 o TIMMER2)
+    uint16_t            dirOCR;         // Dirección OCRnx (8 bits)
+    uint8_t             bitOCIE;        // Bit OCIEnx en TIMSKn
+    uint8_t             mascaraCOM;     // Bits COMnx1:COMnx0 del canal en TCCRnA
+};
+
+//                                      Pin | Canal            | Timer                       | OCRnx | OCIEnx          | COMnx1:COMnx0
+inline constexpr S_CANAL_8BITS TABLA_CANALES_8BITS[] PROGMEM = {
+    { 4,  E_CANAL_OC::OC0B, E_TIMMER_ASCIOADO::TIMMER0, 0x48,   (1 << OCIE0B),   (1 << COM0B1) | (1 << COM0B0) },
+    { 13, E_CANAL_OC::OC0A, E_TIMMER_ASCIOADO::TIMMER0, 0x47,   (1 << OCIE0A),   (1 << COM0A1) | (1 << COM0A0) },
+    { 9,  E_CANAL_OC::OC2B, E_TIMMER_ASCIOADO::TIMMER2, 0xB4,   (1 << OCIE2B),   (1 << COM2B1) | (1 << COM2B0) },
+    { 10, E_CANAL_OC::OC2A, E_TIMMER_ASCIOADO::TIMMER2, 0xB3,   (1 << OCIE2A),   (1 << COM2A1) | (1 << COM2A0) },
+};
+
+// Estado de cada canal compartido con las ISR
+struct S_ESTADO_8BITS {
+    volatile uint8_t*   port;
+    uint8_t             mask;
+    volatile uint16_t   pulso;          // Ticks del timer (0 = sin pulso)
+    volatile uint8_t    ciclosFin;      // Ciclo de la bajada en la trama en curso (0 = ninguna)
+    volatile uint8_t    restoFin;       // Valor de OCRnx de la bajada
+    volatile uint8_t    ciclo;          // Contador de ciclos (solo Timer0, uno por canal)
+};
+
+class ServoMotor8Bits {
+public :
+    uint8_t canal = SIN_CANAL_8BITS;   // Índice en TABLA_CANALES_8BITS
+    const S_TABLA_TICKS* tablaTicks;
+    uint16_t ticksMin = 0;
+    uint16_t ticksMax = 0;
+    int angle = 0;
+    int ticks = 0;
+    char ServoInicializado = 0;
+
+    // Estado de los canales y ciclo de Timer2 (compartidos con las ISR)
+    static S_ESTADO_8BITS estados[NUM_CANALES_8BITS];
+    static volatile uint8_t cicloTimer2;
+
+public :
+    // Constructor
+    ServoMotor8Bits(const PinInfo& pin, const S_TABLA_TICKS* tabla = TABLA_TICKS_SG90);
+    // Metodo para mover el servo a un angulo especifico
+    bool movimientoAngulo(uint8_t angulo);
+    // Metodo para escribir el pulso en ticks de 0.5 µs (limitado al rango del servo)
+    bool escribirTicks(uint16_t ticks);
+    // Metodo para buscar el canal de 8 bits de un pin (SIN_CANAL_8BITS si no tiene)
+    static uint8_t buscarCanal8Bits(uint8_t pin);
+
+    // Atención de las interrupciones (llamados desde las ISR de Timer0/Timer2)
+    static void atenderDesbordeTimer2();
+    static void atenderComparacionTimer0(uint8_t canal, uint16_t dirOCR);
+
+private :
+    // Metodo para configurar Timer2 en modo Normal con prescaler 8 (una sola vez, primer dueño)
+    static void iniciarTimer2();
+};
+
+#endif /* SERVO_8BITS_H */
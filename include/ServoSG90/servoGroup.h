@@ -0,0 +1,54 @@
+#ifndef SERVO_GROUP_H
+#define SERVO_GROUP_H
+
+#include "ServoSG90/servo.h"
+#include "ServoSG90/tramaTimmer.h"
+
+/*
+    ServoGroup: escritura conjunta de varios servos en la misma trama PWM
+    -----------------------------------------------------------------------------------------------
+    Timer3 → pines 2, 3, 5 | Timer4 → pines 6, 7, 8 | Timer1 → pines 11, 12 | Timer5 → pines 44, 45, 46
+
+    Cada ServoMotor actualiza su OCR por separado, así que dos articulaciones pueden cambiar en
+    tramas distintas. El grupo recibe un vector de consignas (en el orden en que se añadieron los
+    servos), las convierte fuera de la sección crítica y las deja preparadas en TramaTimmer dentro
+    de una única sección crítica. Las ISR TOVn las copian a los OCRnx y todos los canales de cada
+    timer cambian en el mismo BOTTOM.
+
+    Ejemplo:
+        ServoGroup brazo;
+        brazo.agregar(hombro);
+        brazo.agregar(codo);
+        uint8_t pose[] = { 45, 120 };
+        brazo.movimientoAngulos(pose, 2);
+*/
+
+constexpr uint8_t MAX_SERVOS_GRUPO = 11;   // Canales OC hardware disponibles para servo
+
+// Datos de cada miembro precalculados al añadirlo (evita buscar el canal en cada escritura)
+struct S_MIEMBRO_GRUPO {
+    ServoMotor*     servo;
+    S_TRAMA_TIMMER* trama;      // Estado de trama del timer del servo
+    uint8_t         bitCanal;   // Bit del canal (A/B/C) en trama->pendientes
+    uint8_t         indice;     // Índice del canal en trama->ticks
+};
+
+class ServoGroup {
+public :
+    S_MIEMBRO_GRUPO miembros[MAX_SERVOS_GRUPO];
+    uint8_t numServos = 0;
+
+public :
+    // Metodo para añadir un servo inicializado al grupo (pasa a modo de actualizacion por trama)
+    bool agregar(ServoMotor& servo);
+    // Metodo para escribir un vector de ticks (uno por servo, en orden de alta)
+    bool escribirTicks(const uint16_t* ticks, uint8_t n);
+    // Metodo para escribir un vector de angulos (uno por servo, en orden de alta)
+    bool movimientoAngulos(const uint8_t* angulos, uint8_t n);
+
+private :
+    // Metodo para preparar todos los valores en una sola seccion critica
+    void confirmar(const uint16_t* ticks, uint8_t n);
+};
+
+#endif /* SERVO_GROUP_H */
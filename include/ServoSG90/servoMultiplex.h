@@ -0,0 +1,98 @@
+#ifndef SERVO_MULTIPLEX_H
+#define SERVO_MULTIPLEX_H
+
+#include "System/pinout/pinout.h"
+#include "ServoSG90/tablaTicks.h"
+#include "ServoSG90/gestorTimmers.h"
+#include <util/atomic.h>
+
+/*
+    ServoMultiplex: hasta 48 servos por software con un único timer de 16 bits (Timer5)
+    -----------------------------------------------------------------------------------------------
+    Los canales OC hardware (PINES_VALIDOS_SERVO) solo permiten 11 servos. Este motor reparte la
+    trama de 20 ms de Timer5 en 8 bancos de 2.5 ms; cada banco genera los pulsos de hasta 6 servos
+    en paralelo sobre pines GPIO (Pins::GPIO), escribiendo directamente en el PORT con port/mask
+    (la misma representación que guarda ServoMotor).
+
+    Trama (Timer5 en CTC, TOP = ICR5 = 39999, tick 0.5 µs):
+
+        | banco 0 | banco 1 | banco 2 | ... | banco 7 |
+        0        5000     10000             35000     40000 ticks
+
+        Inicio de banco: todos sus pines a HIGH (una escritura por puerto).
+        Bajadas: lista ordenada por tiempo → OCR5B apunta siempre al siguiente evento.
+
+    - Plan precalculado: el orden de las bajadas se calcula fuera de la ISR (inserción, ≤ 6
+      elementos) en un buffer inactivo por banco; la ISR lo activa al empezar ese banco.
+    - Jitter acotado: eventos a menos de MARGEN_AGRUPAR_TICKS se atienden en la misma ISR esperando
+      a TCNT5, y un evento ya vencido se atiende de inmediato (nunca se pierde una comparación).
+      El jitter restante es la latencia de otras ISR activas (millis, UART).
+    - Usa OCR5B / TIMER5_COMPB_vect: TIMER5_COMPA_vect queda libre para la librería Servo.
+      Timer5 pasa a CTC: GestorTimmers rechaza servos hardware en los pines 44, 45 y 46 (y al
+      revés, iniciar() falla si Timer5 ya tiene dueño).
+    - Canal c → banco c % 8, posición c / 8: con pocos servos cada uno cae en un banco distinto y
+      los flancos de subida no coinciden.
+*/
+
+constexpr uint8_t  MAX_SERVOS_MULTIPLEX   = 48;
+constexpr uint8_t  NUM_BANCOS_MULTIPLEX   = 8;
+constexpr uint8_t  SERVOS_POR_BANCO       = MAX_SERVOS_MULTIPLEX / NUM_BANCOS_MULTIPLEX;
+constexpr uint16_t TICKS_BANCO_MULTIPLEX  = 5000;     // 2.5 ms ≥ pulso máximo (2400 µs)
+constexpr uint16_t TICKS_TRAMA_MULTIPLEX  = TICKS_BANCO_MULTIPLEX * NUM_BANCOS_MULTIPLEX;   // 20 ms
+constexpr uint8_t  MARGEN_AGRUPAR_TICKS   = 20;       // 10 µs: más cerca que esto, misma ISR
+constexpr int8_t   SIN_CANAL_MULTIPLEX    = -1;
+
+// Salida digital: registro PORT y máscara del bit
+struct S_SALIDA_PIN {
+    volatile uint8_t* port;
+    uint8_t           mask;
+};
+
+// Bajada de un pin: tiempo relativo al inicio del banco
+struct S_EVENTO_BAJADA {
+    uint16_t          tiempo;
+    volatile uint8_t* port;
+    uint8_t           mask;
+};
+
+// Plan de un banco: subidas agrupadas por puerto y bajadas ordenadas
+struct S_PLAN_BANCO {
+    S_SALIDA_PIN    subidas[SERVOS_POR_BANCO];
+    uint8_t         numSubidas;
+    S_EVENTO_BAJADA bajadas[SERVOS_POR_BANCO];
+    uint8_t         numBajadas;
+};
+
+class ServoMultiplex {
+public :
+    // Metodo para configurar Timer5 y arrancar la trama multiplexada (false si Timer5 está ocupado)
+    static bool iniciar();
+    // Metodo para añadir un pin GPIO; devuelve el canal o SIN_CANAL_MULTIPLEX
+    static int8_t agregar(const PinInfo& pin);
+    // Metodo para escribir el pulso de un canal en ticks de 0.5 µs (limitado a la tabla SG90)
+    static bool escribirTicks(uint8_t canal, uint16_t ticks);
+    // Metodo para mover un canal a un angulo (tabla SG90 en flash)
+    static bool movimientoAngulo(uint8_t canal, uint8_t angulo);
+    // Atención de la comparación OCR5B (llamado desde TIMER5_COMPB_vect)
+    static void atenderInterrupcion();
+
+private :
+    // Metodo para reconstruir el plan inactivo de un banco y pedir su activacion
+    static void construirPlan(uint8_t banco);
+
+private :
+    static S_SALIDA_PIN     salidas[MAX_SERVOS_MULTIPLEX];
+    static uint16_t         ticks[MAX_SERVOS_MULTIPLEX];
+    static uint8_t          numServos;
+
+    static S_PLAN_BANCO     planes[NUM_BANCOS_MULTIPLEX][2];
+    static volatile uint8_t planActivo[NUM_BANCOS_MULTIPLEX];
+    static volatile uint8_t planesPendientes;      // Bit b = banco b con plan nuevo listo
+
+    // Estado de la ISR
+    static uint8_t          bancoActual;
+    static uint8_t          eventoActual;
+    static S_PLAN_BANCO*    planEnCurso;
+};
+
+#endif /* SERVO_MULTIPLEX_H */
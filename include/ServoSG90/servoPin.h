@@ -0,0 +1,161 @@
+#ifndef SERVO_PIN_H
+#define SERVO_PIN_H
+
+#include "System/pinout/pinout.h"
+#include "ServoSG90/timmer.h"
+#include "ServoSG90/servo.h"
+#include "ServoSG90/tramaTimmer.h"
+#include "ServoSG90/gestorTimmers.h"
+
+/*
+    ServoMotorPin<PIN>: variante de ServoMotor resuelta en compilación
+    -----------------------------------------------------------------------------------------------
+    - El pin se valida con static_assert contra PINES_VALIDOS_SERVO y TABLA_CANALES_OC.
+    - El descriptor del canal se copia en compilación: las direcciones TCCRnA/TCCRnB/ICRn/OCRnx
+      son constantes y la escritura del OCR compila a un par de instrucciones "sts".
+    - No imprime mensajes por Serial. Su único estado en RAM es un flag por tipo: si GestorTimmers
+      rechaza la reserva (el canal ya tiene dueño o el timer está en otro modo) el constructor no
+      toca ningún registro, inicializado() devuelve false y los métodos de escritura devuelven
+      false sin escribir el OCR, que sigue siendo del otro dueño.
+
+    ServoMotor sigue disponible para pines elegidos en tiempo de ejecución.
+
+    Se crea como static local de setup() (un objeto global se construiría antes de init() del core,
+    que vuelve a configurar los timers). Los métodos son static: loop() usa el tipo.
+
+    Ejemplo:
+        void setup() {
+            static ServoMotorPin<2> servo;             // OC3B → Timer3, rango SG90 (544–2400 µs)
+            static ServoMotorPin<6, 1000, 2000> otro;  // Rango de pulso propio
+            if (!servo.inicializado()) return;      // Canal ocupado: no mueve nada
+            servo.movimientoAngulo(90);
+        }
+        void loop() { ServoMotorPin<2>::escribirTicks(3000); }
+        static ServoMotorPin<10> mal;                  // error de compilación: pin no disponible para servo
+*/
+
+// Comprueba en compilación si un pin está en PINES_VALIDOS_SERVO
+constexpr bool pinValidoServo(int pin) {
+    for (int p : PINES_VALIDOS_SERVO) {
+        if (pin == p) return true;
+    }
+    return false;
+}
+
+// Índice del canal OC de un pin. Lee TABLA_PIN_CANAL (flash): usar solo en expresiones constexpr
+constexpr uint8_t indiceCanalOCConstexpr(int pin) {
+    return (pin >= 0 && pin < NUM_PINES_CANAL_OC) ? TABLA_PIN_CANAL.indice[pin] : SIN_CANAL_OC;
+}
+
+template <uint8_t PIN, uint16_t MIN_US = PULSO_MIN_US_SG90, uint16_t MAX_US = PULSO_MAX_US_SG90>
+class ServoMotorPin {
+    static_assert(pinValidoServo(PIN), "Pin no disponible para servo SG90 (ver PINES_VALIDOS_SERVO)");
+    static_assert(indiceCanalOCConstexpr(PIN) != SIN_CANAL_OC, "Pin sin canal OC de 16 bits en TABLA_CANALES_OC");
+
+public :
+    // Descriptor del canal resuelto en compilación
+    static constexpr S_CANAL_OC CANAL     = TABLA_CANALES_OC[indiceCanalOCConstexpr(PIN)];
+    static constexpr uint16_t   DIR_TCCRA = CANAL.dirTCCRA;
+    static constexpr uint16_t   DIR_TCCRB = CANAL.dirTCCRB;
+    static constexpr uint16_t   DIR_ICR   = CANAL.dirICR;
+    static constexpr uint16_t   DIR_OCR   = CANAL.dirOCR;
+
+public :
+    // Constructor: pin como salida y timer en Fast PWM (TOP = ICRn), igual que Timmer::initTimmer
+    ServoMotorPin() {
+        //Reserva del canal en GestorTimmers: si el timer ya está en Fast PWM con el mismo TOP solo se
+        //configura el canal; con otro dueño incompatible no se toca ningún registro
+        E_RESERVA_TIMMER reserva = GestorTimmers::reservar(CANAL.timmer, E_MODO_TIMMER::FAST_PWM_ICR, Timmer::icrTramaServo,
+                                                           TramaTimmer::indiceCanal(CANAL), "ServoMotorPin");
+        if (reserva == E_RESERVA_TIMMER::CONFLICTO) return;
+        reservado = true;
+
+        volatile uint8_t* ddr  = portModeRegister(digitalPinToPort(PIN));
+        volatile uint8_t* port = portOutputRegister(digitalPinToPort(PIN));
+        uint8_t mask = digitalPinToBitMask(PIN);
+        *port &= ~mask;
+        *ddr  |= mask;
+
+        if (reserva == E_RESERVA_TIMMER::CONFIGURAR) {
+            //Formato Fast PWM con ICRn como TOP y prescaler limpio
+            _SFR_MEM8(DIR_TCCRA) &= ~((1 << WGM10) | (1 << WGM11));
+            _SFR_MEM8(DIR_TCCRB) &= ~((1 << WGM12) | (1 << WGM13) | (1 << CS10) | (1 << CS11) | (1 << CS12));
+            _SFR_MEM8(DIR_TCCRA) |= (1 << WGM11);
+            _SFR_MEM8(DIR_TCCRB) |= (1 << WGM13) | (1 << WGM12);
+        }
+
+        //Compare Output Mode: Clear on Compare, Set at TOP
+        _SFR_MEM8(DIR_TCCRA) &= ~(CANAL.mascaraCOM1 | CANAL.mascaraCOM0);
+        _SFR_MEM8(DIR_TCCRA) |= CANAL.mascaraCOM1;
+
+        // Pulso inicial de 1.5 ms; periodo de trama (20 ms por defecto) y prescaler 8 (tick 0.5 µs) solo al configurar
+        escribirTicks(TICKS_PULSO_INICIAL);
+        if (reserva == E_RESERVA_TIMMER::CONFIGURAR) {
+            ATOMIC_BLOCK(ATOMIC_RESTORESTATE) {
+                _SFR_MEM16(DIR_ICR) = Timmer::icrTramaServo;
+            }
+            _SFR_MEM8(DIR_TCCRB) |= (1 << CS11);
+        }
+    }
+
+    // Metodo para saber si el constructor reservó el canal (false: las escrituras no hacen nada)
+    static inline bool inicializado() {
+        return reservado;
+    }
+
+    // Límites del pulso en ticks (resueltos en compilación)
+    static constexpr uint16_t TICKS_MIN = TablaTicks<MIN_US, MAX_US>::datos.ticks[0];
+    static constexpr uint16_t TICKS_MAX = TablaTicks<MIN_US, MAX_US>::datos.ticks[ANGULO_MAX_SERVO];
+
+    // Metodo para escribir directamente los ticks del pulso (un par "sts" con interrupciones
+    // bloqueadas por el registro TEMP, sin limitar el rango)
+    static inline bool escribirTicks(uint16_t ticks) {
+        if (!reservado) return false;
+        ATOMIC_BLOCK(ATOMIC_RESTORESTATE) {
+            _SFR_MEM16(DIR_OCR) = ticks;
+        }
+        return true;
+    }
+
+    // Metodo para dejar los ticks preparados y aplicarlos al inicio de la siguiente trama
+    static inline bool prepararTicks(uint16_t ticks) {
+        if (!reservado) return false;
+        TramaTimmer::prepararOCR(CANAL, ticks);
+        return true;
+    }
+
+    // Metodo para habilitar la confirmacion por trama (ISR TOVn del timer)
+    static inline bool habilitarTrama() {
+        if (!reservado) return false;
+        TramaTimmer::habilitar(CANAL);
+        return true;
+    }
+
+    // Metodo para escribir el pulso en microsegundos (limitado a MIN_US–MAX_US)
+    static inline bool escribirMicrosegundos(uint16_t us) {
+        if (us < MIN_US) us = MIN_US;
+        if (us > MAX_US) us = MAX_US;
+        return escribirTicks(us * TICKS_POR_US);
+    }
+
+    // Metodo para mover el servo en centesimas de grado (0-18000, interpolado)
+    static inline bool movimientoCentigrados(uint16_t centigrados) {
+        return movimientoAnguloQ8(centigradosAQ8(centigrados));
+    }
+
+    // Metodo para mover el servo a un angulo especifico (tabla en flash del rango MIN_US–MAX_US)
+    static inline bool movimientoAngulo(uint8_t angulo) {
+        return escribirTicks(anguloATicks(&TablaTicks<MIN_US, MAX_US>::datos, angulo));
+    }
+
+    // Metodo para mover el servo a un angulo con fraccion (Q8: grados × 256, interpolado)
+    static inline bool movimientoAnguloQ8(uint16_t anguloQ8) {
+        return escribirTicks(anguloQ8ATicks(&TablaTicks<MIN_US, MAX_US>::datos, anguloQ8));
+    }
+
+private :
+    // Reserva aceptada por GestorTimmers (un flag por tipo: lo comparten todas las instancias)
+    static inline bool reservado = false;
+};
+
+#endif /* SERVO_PIN_H */
@@ -0,0 +1,61 @@
+#ifndef SINCRONIZADOR_H
+#define SINCRONIZADOR_H
+
+#include "ServoSG90/timmer.h"
+#include "ServoSG90/gestorTimmers.h"
+
+/*
+    SincronizadorTimmers: inicios de trama repartidos entre Timer1, Timer3, Timer4 y Timer5
+    -----------------------------------------------------------------------------------------------
+    Cada timer de servo se configura al crear su primer servo, con pocos µs de diferencia: los
+    flancos de subida de todos los canales coinciden y los picos de corriente se suman. La caída de
+    la fuente con muchos canales en movimiento llega a reiniciar la placa.
+
+    sincronizar() detiene el prescaler común (GTCCR: TSM = 1, PSRSYNC = 1), carga el contador de
+    cada timer y lo suelta a la vez. Cada timer llega a BOTTOM (subida de sus pulsos) su desfase
+    después del arranque:
+
+        TCNTn = ICRn − desfase_n
+
+    Por defecto los timers en Fast PWM (TOP = ICRn) con el mismo TOP se reparten a partes iguales:
+    desfase_k = MARGEN + k · ICR / N (4 timers → 5 ms entre inicios de trama). configurarDesfase()
+    fija el de un timer a mano.
+
+    Un pulso en curso no puede moverse: si TCNTn saltara por encima de OCRnx con la salida en
+    alto, el pulso duraría hasta la comparación de la trama siguiente. Por eso sincronizar() espera
+    (como mucho dos tramas, con interrupciones habilitadas) un instante en que todos los contadores
+    han pasado la comparación de sus canales conectados, y los nuevos TCNTn quedan también por
+    encima de ella. Durante la parada (unos µs) Timer0 también se detiene: millis() se retrasa
+    ese tiempo.
+
+    Ejemplo:
+        // Tras crear los servos
+        SincronizadorTimmers::sincronizar();
+*/
+
+constexpr uint16_t MARGEN_SINCRONIZACION = 200;       // Ticks (100 µs) de margen frente a OCR y TOP
+constexpr uint8_t  TRAMAS_ESPERA_SINCRONIZACION = 2;   // Espera máxima (40 ms a 50 Hz)
+
+// Dirección base (TCCRnA) de los registros de cada timer de 16 bits (0 = timer de 8 bits)
+constexpr uint16_t DIR_BASE_TIMMER[NUM_TIMMERS] = { 0, 0x80, 0, 0x90, 0xA0, 0x120 };
+constexpr uint8_t  OFFSET_TCNT_TIMMER = 4;
+constexpr uint8_t  OFFSET_ICR_TIMMER  = 6;
+constexpr uint8_t  OFFSET_OCRA_TIMMER = 8;
+
+class SincronizadorTimmers {
+public :
+    // Desfase de cada timer en ticks (0 = reparto automático)
+    static uint16_t desfases[NUM_TIMMERS];
+
+public :
+    // Metodo para fijar el desfase de un timer: ticks desde el arranque comun hasta su BOTTOM (0 = automatico)
+    static bool configurarDesfase(E_TIMMER_ASCIOADO timmer, uint16_t ticks);
+    // Metodo para arrancar a la vez los timers de servo con sus desfases (devuelve cuantos se sincronizaron)
+    static uint8_t sincronizar();
+
+private :
+    // Mayor OCR de los canales conectados del timer (0 si no hay ninguno)
+    static uint16_t comparacionMaxima(uint16_t base);
+};
+
+#endif /* SINCRONIZADOR_H */
@@ -0,0 +1,58 @@
+#ifndef SUAVIZADO_H
+#define SUAVIZADO_H
+
+#include <Arduino.h>
+
+/*
+    Suavizado: curvas de aceleración en tablas de flash
+    -----------------------------------------------------------------------------------------------
+    Un movimiento temporizado (CoordinadorServos, ReproductorAnimacion) avanza un progreso t de
+    0 a 1 en Q16 y escribe inicio + (destino − inicio) · curva(t). Evaluar los polinomios con float
+    cuesta cientos de ciclos por servo y trama; aquí cada curva es una tabla de 129 valores Q16 en
+    flash y la evaluación son dos pgm_read_word y una interpolación lineal:
+
+        índice = t >> 9,  fracción = t & 0x1FF
+        curva(t) = T[índice] + (T[índice + 1] − T[índice]) · fracción >> 9
+
+    Curvas (t en [0, 1]):
+        LINEAL          t (sin tabla)
+        SUAVE           3t² − 2t³
+        ENTRADA         t²                          arranca despacio
+        SALIDA          1 − (1 − t)²                frena al final
+        ENTRADA_SALIDA  cuadrática por tramos        arranca y frena
+        CUBICA          cúbica por tramos           arranca y frena más suave
+        SENO            (1 − cos(πt)) / 2
+        REBOTE          rebote al llegar (easeOutBounce)
+
+    REBOTE no usa tabla: sus esquinas entre botes darían un 1.6 % de error interpolando. Se
+    evalúa por tramos (t − c)² · 121/16 + k con una multiplicación de 32 bits.
+
+    El error es menor que 0.02 % del recorrido (< 1 tick en 3712); test/test_suavizado lo comprueba
+    en el PC frente a las fórmulas en double (pio test -e native).
+*/
+
+constexpr uint8_t PASOS_TABLA_SUAVIZADO     = 128;
+constexpr uint8_t DESPLAZAMIENTO_SUAVIZADO  = 9;      // 65536 / 128 = 2^9
+constexpr uint8_t NUM_TABLAS_SUAVIZADO      = 6;      // SUAVE..SENO (REBOTE se calcula)
+
+// Curvas de suavizado (el valor se guarda en flash en los fotogramas de animación)
+enum class E_SUAVIZADO : uint8_t {
+    LINEAL          = 0,
+    SUAVE           = 1,
+    ENTRADA         = 2,
+    SALIDA          = 3,
+    ENTRADA_SALIDA  = 4,
+    CUBICA          = 5,
+    SENO            = 6,
+    REBOTE          = 7,
+};
+
+extern const uint16_t TABLA_SUAVIZADO[NUM_TABLAS_SUAVIZADO][PASOS_TABLA_SUAVIZADO + 1];
+
+class Suavizado {
+public :
+    // Metodo para aplicar una curva a un progreso Q16 (0-65535)
+    static uint16_t aplicar(E_SUAVIZADO curva, uint16_t t);
+};
+
+#endif /* SUAVIZADO_H */
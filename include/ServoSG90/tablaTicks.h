@@ -0,0 +1,97 @@
+#ifndef TABLA_TICKS_H
+#define TABLA_TICKS_H
+
+#include <Arduino.h>
+
+/*
+    Tabla ángulo → ticks en flash (PROGMEM)
+    -----------------------------------------------------------------------------------------------
+    Sustituye a map(angulo, 0, 180, minUs, maxUs) * 2 en el camino de actualización del servo.
+    map() realiza una multiplicación y una división de 32 bits (el ATmega2560 no tiene divisor
+    hardware, __divmodsi4 cuesta cientos de ciclos). La tabla se genera en compilación con la
+    misma relación lineal que map(), pero calculada directamente en ticks y redondeada (map()
+    truncaba a µs antes de multiplicar por 2), y cada conversión queda en una lectura pgm_read_word.
+
+    - 181 entradas de 16 bits (362 bytes de flash) por rango de pulso.
+    - Ticks de 0.5 µs (prescaler 8): ticks = µs × 2.
+    - Ángulos con fracción: formato Q8 (grados × 256), interpolación lineal entre dos entradas
+      con una multiplicación 16×8 (instrucción MUL) y sin división.
+*/
+
+constexpr uint8_t  ANGULO_MAX_SERVO   = 180;     // Grados
+constexpr uint16_t PULSO_MIN_US_SG90  = 544;     // Pulso a 0°   (µs)
+constexpr uint16_t PULSO_MAX_US_SG90  = 2400;    // Pulso a 180° (µs)
+constexpr uint8_t  TICKS_POR_US       = 2;       // Prescaler 8 → tick de 0.5 µs
+
+struct S_TABLA_TICKS {
+    uint16_t ticks[ANGULO_MAX_SERVO + 1];
+};
+
+// Genera la tabla: interpolación lineal minUs–maxUs a resolución de tick, con redondeo
+constexpr S_TABLA_TICKS generarTablaTicks(uint16_t minUs, uint16_t maxUs) {
+    S_TABLA_TICKS tabla{};
+    for (uint16_t a = 0; a <= ANGULO_MAX_SERVO; a++) {
+        uint32_t rango = (uint32_t)(maxUs - minUs) * TICKS_POR_US;
+        uint32_t delta = (a * rango + ANGULO_MAX_SERVO / 2) / ANGULO_MAX_SERVO;
+        tabla.ticks[a] = (uint16_t)(minUs * TICKS_POR_US + delta);
+    }
+    return tabla;
+}
+
+// Una tabla en flash por cada rango de pulso utilizado
+template <uint16_t MIN_US, uint16_t MAX_US>
+struct TablaTicks {
+    static_assert(MIN_US < MAX_US, "Rango de pulso no valido");
+    static constexpr S_TABLA_TICKS datos PROGMEM = generarTablaTicks(MIN_US, MAX_US);
+};
+
+// Tabla por defecto del SG90 (544–2400 µs)
+inline constexpr const S_TABLA_TICKS* TABLA_TICKS_SG90 = &TablaTicks<PULSO_MIN_US_SG90, PULSO_MAX_US_SG90>::datos;
+
+// Conversión ángulo entero → ticks (una lectura de flash)
+inline uint16_t anguloATicks(const S_TABLA_TICKS* tabla, uint8_t angulo) {
+    if (angulo > ANGULO_MAX_SERVO) angulo = ANGULO_MAX_SERVO;
+    return pgm_read_word(&tabla->ticks[angulo]);
+}
+
+// Conversión ángulo Q8 (grados × 256) → ticks con interpolación lineal entre dos entradas
+inline uint16_t anguloQ8ATicks(const S_TABLA_TICKS* tabla, uint16_t anguloQ8) {
+    uint8_t entero = anguloQ8 >> 8;
+    uint8_t fraccion = anguloQ8 & 0xFF;
+    if (entero >= ANGULO_MAX_SERVO) return pgm_read_word(&tabla->ticks[ANGULO_MAX_SERVO]);
+
+    uint16_t t0 = pgm_read_word(&tabla->ticks[entero]);
+    uint8_t  paso = pgm_read_word(&tabla->ticks[entero + 1]) - t0;     // < 256 ticks por grado
+    return t0 + (((uint16_t)paso * fraccion) >> 8);
+}
+
+// Conversión ángulo Q8 → ticks Q8 (ticks × 256) sin descartar la fracción (dithering temporal)
+inline uint32_t anguloQ8ATicksQ8(const S_TABLA_TICKS* tabla, uint16_t anguloQ8) {
+    uint8_t entero = anguloQ8 >> 8;
+    uint8_t fraccion = anguloQ8 & 0xFF;
+    if (entero >= ANGULO_MAX_SERVO) return (uint32_t)pgm_read_word(&tabla->ticks[ANGULO_MAX_SERVO]) << 8;
+
+    uint16_t t0 = pgm_read_word(&tabla->ticks[entero]);
+    uint8_t  paso = pgm_read_word(&tabla->ticks[entero + 1]) - t0;
+    return ((uint32_t)t0 << 8) + (uint16_t)paso * fraccion;
+}
+
+// Conversión inversa ticks → ángulo Q8 con la recta del servo: ticks = ticksCero ± ángulo · pendiente
+// (− si está invertido). Limitada a 0–180°; una división de 32 bits (fuera de la ISR)
+inline uint16_t ticksAAnguloQ8(uint16_t ticks, uint16_t ticksCero, uint16_t ticksPorGradoQ8, bool invertido) {
+    if (ticksPorGradoQ8 == 0) return 0;
+    int32_t delta = invertido ? (int32_t)ticksCero - ticks : (int32_t)ticks - ticksCero;
+    if (delta <= 0) return 0;
+
+    uint32_t q8 = (((uint32_t)delta << 16) + ticksPorGradoQ8 / 2) / ticksPorGradoQ8;
+    if (q8 > ((uint32_t)ANGULO_MAX_SERVO << 8)) q8 = (uint32_t)ANGULO_MAX_SERVO << 8;
+    return (uint16_t)q8;
+}
+
+// Conversión centésimas de grado (0–18000) → Q8: cg × 256 / 100 ≈ (cg × 41943 + 2^13) >> 14, redondeado y sin división
+inline uint16_t centigradosAQ8(uint16_t centigrados) {
+    if (centigrados > ANGULO_MAX_SERVO * 100U) centigrados = ANGULO_MAX_SERVO * 100U;
+    return ((uint32_t)centigrados * 41943UL + 8192UL) >> 14;
+}
+
+#endif /* TABLA_TICKS_H */
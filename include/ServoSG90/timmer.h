@@ -3,6 +3,7 @@
 
 #include "System/pinout/pinout.h"
 #include "System/msg/msg.h"                                          
+#include <util/atomic.h>
 
 #define DEBUG_SERVO_SG90  1
 
@@ -20,6 +21,9 @@ enum class E_CANAL_OC {
     OC1A = 10,
     OC1B = 11,
     OC1C = 12,
+    OC5A = 13,
+    OC5B = 14,
+    OC5C = 15,
    
 };
 
@@ -28,6 +32,8 @@ enum class E_TIMMER_ASCIOADO {
     TIMMER1 = 1,
     TIMMER2 = 2,
     TIMMER3 = 3,
+    TIMMER4 = 4,
+    TIMMER5 = 5,
 
 };
 
@@ -45,6 +51,9 @@ enum class E_REGISTRO_OCR {
     OCR_1B = 10,
     OCR_1C = 11,
     OCR_0A = 12,
+    OCR_5A = 13,
+    OCR_5B = 14,
+    OCR_5C = 15,
 };
 
 enum class E_REGISTRO_ICR {
@@ -57,6 +66,140 @@ enum class E_REGISTRO_ICR {
     ICR_5 = 6,
 };
 
+/*
+    Descriptor de canal OC (solo timers de 16 bits)
+    -----------------------------------------------------------------------------------------------
+    Guarda las direcciones en espacio de datos de los registros del timer (datasheet ATmega2560,
+    "Register Summary") y las máscaras COM del canal. Con _SFR_MEM8/_SFR_MEM16 se accede al
+    registro directamente a partir de la dirección, sin cadenas de switch/if por pin:
+
+        _SFR_MEM16(canal.dirOCR) = ticks;   // equivale a OCR3B = ticks para el pin 2
+
+    Los bits WGMn0..WGMn3, CSn0..CSn2 y COMnx1:COMnx0 ocupan la misma posición en Timer1/3/4/5,
+    por lo que la misma secuencia de configuración sirve para cualquier canal de la tabla.
+*/
+struct S_CANAL_OC {
+    uint8_t             pin;            // Pin Arduino
+    E_CANAL_OC          canalOC;        // Canal Output Compare
+    E_TIMMER_ASCIOADO   timmer;         // Timer asociado
+    E_REGISTRO_OCR      registroOCR;    // Registro OCR (identificador)
+    E_REGISTRO_ICR      registroICR;    // Registro ICR (identificador)
+    uint16_t            dirTCCRA;       // Dirección TCCRnA
+    uint16_t            dirTCCRB;       // Dirección TCCRnB
+    uint16_t            dirICR;         // Dirección ICRn (16 bits)
+    uint16_t            dirOCR;         // Dirección OCRnx (16 bits)
+    uint16_t            dirTIMSK;       // Dirección TIMSKn (habilitación de interrupciones)
+    uint8_t             mascaraCOM1;    // Bit COMnx1 del canal en TCCRnA
+    uint8_t             mascaraCOM0;    // Bit COMnx0 del canal en TCCRnA
+};
+
+// Tabla de canales OC de 16 bits utilizables para servo (en flash)
+//                                  Pin | Canal            | Timer                       | OCR                    | ICR                   | TCCRnA | TCCRnB | ICRn  | OCRnx | TIMSKn | COMnx1         | COMnx0
+inline constexpr S_CANAL_OC TABLA_CANALES_OC[] PROGMEM = {
+    { 2,  E_CANAL_OC::OC3B, E_TIMMER_ASCIOADO::TIMMER3, E_REGISTRO_OCR::OCR_3B, E_REGISTRO_ICR::ICR_3, 0x90,    0x91,    0x96,   0x9A,   0x71,   (1 << COM3B1), (1 << COM3B0) },
+    { 3,  E_CANAL_OC::OC3C, E_TIMMER_ASCIOADO::TIMMER3, E_REGISTRO_OCR::OCR_3C, E_REGISTRO_ICR::ICR_3, 0x90,    0x91,    0x96,   0x9C,   0x71,   (1 << COM3C1), (1 << COM3C0) },
+    { 5,  E_CANAL_OC::OC3A, E_TIMMER_ASCIOADO::TIMMER3, E_REGISTRO_OCR::OCR_3A, E_REGISTRO_ICR::ICR_3, 0x90,    0x91,    0x96,   0x98,   0x71,   (1 << COM3A1), (1 << COM3A0) },
+    { 6,  E_CANAL_OC::OC4A, E_TIMMER_ASCIOADO::TIMMER4, E_REGISTRO_OCR::OCR_4A, E_REGISTRO_ICR::ICR_4, 0xA0,    0xA1,    0xA6,   0xA8,   0x72,   (1 << COM4A1), (1 << COM4A0) },
+    { 7,  E_CANAL_OC::OC4B, E_TIMMER_ASCIOADO::TIMMER4, E_REGISTRO_OCR::OCR_4B, E_REGISTRO_ICR::ICR_4, 0xA0,    0xA1,    0xA6,   0xAA,   0x72,   (1 << COM4B1), (1 << COM4B0) },
+    { 8,  E_CANAL_OC::OC4C, E_TIMMER_ASCIOADO::TIMMER4, E_REGISTRO_OCR::OCR_4C, E_REGISTRO_ICR::ICR_4, 0xA0,    0xA1,    0xA6,   0xAC,   0x72,   (1 << COM4C1), (1 << COM4C0) },
+    { 11, E_CANAL_OC::OC1A, E_TIMMER_ASCIOADO::TIMMER1, E_REGISTRO_OCR::OCR_1A, E_REGISTRO_ICR::ICR_1, 0x80,    0x81,    0x86,   0x88,   0x6F,   (1 << COM1A1), (1 << COM1A0) },
+    { 12, E_CANAL_OC::OC1B, E_TIMMER_ASCIOADO::TIMMER1, E_REGISTRO_OCR::OCR_1B, E_REGISTRO_ICR::ICR_1, 0x80,    0x81,    0x86,   0x8A,   0x6F,   (1 << COM1B1), (1 << COM1B0) },
+    { 44, E_CANAL_OC::OC5C, E_TIMMER_ASCIOADO::TIMMER5, E_REGISTRO_OCR::OCR_5C, E_REGISTRO_ICR::ICR_5, 0x120,   0x121,   0x126,  0x12C,  0x73,   (1 << COM5C1), (1 << COM5C0) },
+    { 45, E_CANAL_OC::OC5B, E_TIMMER_ASCIOADO::TIMMER5, E_REGISTRO_OCR::OCR_5B, E_REGISTRO_ICR::ICR_5, 0x120,   0x121,   0x126,  0x12A,  0x73,   (1 << COM5B1), (1 << COM5B0) },
+    { 46, E_CANAL_OC::OC5A, E_TIMMER_ASCIOADO::TIMMER5, E_REGISTRO_OCR::OCR_5A, E_REGISTRO_ICR::ICR_5, 0x120,   0x121,   0x126,  0x128,  0x73,   (1 << COM5A1), (1 << COM5A0) },
+};
+
+constexpr uint8_t NUM_CANALES_OC      = sizeof(TABLA_CANALES_OC) / sizeof(TABLA_CANALES_OC[0]);
+constexpr uint16_t ICR_TRAMA_SERVO    = 40000;  // TOP de la trama de 20 ms (40000 ticks × 0.5 µs)
+constexpr uint16_t HZ_TRAMA_SERVO     = 50;     // Trama por defecto de los servos analógicos
+constexpr uint16_t HZ_TRAMA_SERVO_MIN = 50;     // Rango de configurarTramaServo()
+constexpr uint16_t HZ_TRAMA_SERVO_MAX = 400;    // Servos digitales: trama de 2.5 ms
+constexpr uint16_t PRESCALER_SERVO    = 8;      // Tick de 0.5 µs: unidad de las tablas, perfiles y límites
+constexpr uint16_t TICKS_PULSO_INICIAL = 3000;  // Pulso de 1.5 ms (centro) por defecto al inicializar
+constexpr uint8_t NUM_PINES_CANAL_OC  = 47;     // Pines 0..46 (último pin con salida OC en la Mega)
+constexpr uint8_t SIN_CANAL_OC        = 0xFF;   // Marca de pin sin canal OC de 16 bits
+
+// Índice pin → posición en TABLA_CANALES_OC, generado en compilación a partir de la propia tabla
+struct S_TABLA_PIN_CANAL {
+    uint8_t indice[NUM_PINES_CANAL_OC];
+};
+
+constexpr S_TABLA_PIN_CANAL generarTablaPinCanal() {
+    S_TABLA_PIN_CANAL tabla{};
+    for (uint8_t p = 0; p < NUM_PINES_CANAL_OC; p++) tabla.indice[p] = SIN_CANAL_OC;
+    for (uint8_t i = 0; i < NUM_CANALES_OC; i++) tabla.indice[TABLA_CANALES_OC[i].pin] = i;
+    return tabla;
+}
+
+inline constexpr S_TABLA_PIN_CANAL TABLA_PIN_CANAL PROGMEM = generarTablaPinCanal();
+
+/*
+    Reloj de un timer de 16 bits: prescaler y TOP
+    -----------------------------------------------------------------------------------------------
+    seleccionarReloj() recorre los prescalers de menor a mayor y se queda con el primero cuyo TOP
+    cabe en 16 bits: el tick más corto posible, es decir, la mayor resolución de ciclo de trabajo
+    para esa frecuencia.
+
+        Fast PWM (TOP = ICRn)            f = F_CPU / (N · (TOP + 1))
+        Phase Correct PWM (TOP = ICRn)   f = F_CPU / (2 · N · TOP)
+
+    Ejemplo (16 MHz): 50 Hz Fast PWM → N = 8, TOP = 39999; 1 kHz → N = 1, TOP = 15999.
+
+    La trama de los servos (configurarTramaServo) no pasa por aquí: mantiene N = 8 para que un
+    tick siga siendo 0.5 µs (tablas ángulo → ticks, perfiles de calibración, límites y ServoPin
+    están en esa unidad) y solo cambia el TOP. Entre 50 y 400 Hz el TOP va de 40000 a 5000 ticks
+    sin salir de 16 bits (ICRn = 2 MHz / hz, 40000 a 50 Hz como hasta ahora): la resolución del
+    pulso no cambia y la latencia de control baja de 20 ms a 2.5 ms.
+*/
+constexpr uint8_t  NUM_PRESCALERS_TIMMER = 5;
+constexpr uint16_t PRESCALERS_TIMMER[NUM_PRESCALERS_TIMMER] = { 1, 8, 64, 256, 1024 };   // CSn2:0 = índice + 1
+
+struct S_RELOJ_TIMMER {
+    uint16_t prescaler;     // Divisor (1, 8, 64, 256, 1024)
+    uint8_t  bitsCS;        // CSn2:CSn0
+    uint16_t top;           // ICRn
+};
+
+/*
+    PWM de uso general (LEDs, ventiladores, drivers de motor)
+    -----------------------------------------------------------------------------------------------
+    iniciarPWM() configura el canal con la frecuencia pedida sobre la misma TABLA_CANALES_OC que
+    los servos, en lugar del PWM fijo de 8 bits de analogWrite() (490/980 Hz):
+
+        RAPIDO         Fast PWM, TOP = ICRn       (WGMn3:0 = 1110)
+        FASE_CORRECTA  Phase Correct, TOP = ICRn  (WGMn3:0 = 1010) pulsos centrados, sin
+                       desplazamiento de fase al cambiar el ciclo (puentes H, motores)
+
+    El ciclo de trabajo es de 16 bits (0 = apagado, 65535 = encendido) y se escala al TOP elegido
+    por seleccionarReloj() con una multiplicación 16×16 (sin división). Con invertido la salida
+    usa COMnx1:COMnx0 = 11: "encendido" es nivel bajo (drivers activos a nivel bajo, LEDs a Vcc).
+
+    En Fast PWM, OCRnx = 0 todavía da un pulso de un tick por periodo; el ciclo 0 desconecta la
+    salida y deja el pin en su nivel de apagado. Los OCR tienen doble buffer (se cargan en BOTTOM
+    o en TOP), así que un cambio de ciclo nunca corta un periodo.
+
+    Un canal PWM comparte timer solo con canales del mismo modo, TOP y prescaler (GestorTimmers):
+    un ventilador a 25 kHz no cabe en un timer con servos.
+
+    Ejemplo:
+        Timmer ventilador(Pins::PWM[4]);                 // Pin 6, OC4A
+        ventilador.iniciarPWM(25000);                    // 25 kHz, fuera del rango audible
+        ventilador.escribirCiclo(49152);                 // 75 %
+*/
+enum class E_TIPO_PWM : uint8_t {
+    SERVO         = 0,    // Trama de servo (initTimmer)
+    RAPIDO        = 1,    // Fast PWM, TOP = ICRn
+    FASE_CORRECTA = 2,    // Phase Correct PWM, TOP = ICRn
+};
+
+// Escritura atómica de un registro de 16 bits: el acceso pasa por el registro TEMP compartido
+// del timer, por lo que una ISR que toque otro registro de 16 bits entre los dos bytes lo corrompe
+inline void escribirRegistro16Atomico(uint16_t direccion, uint16_t valor) {
+    ATOMIC_BLOCK(ATOMIC_RESTORESTATE) {
+        _SFR_MEM16(direccion) = valor;
+    }
+}
+
 class Timmer {
     public:
         // Información del pin asociado al timer
@@ -69,9 +212,22 @@ class Timmer {
         int registroOCRData;
         E_REGISTRO_ICR registroICR;
         uint16_t registroICRData;
+        // Descriptor del canal (copia en RAM de TABLA_CANALES_OC)
+        S_CANAL_OC canal{};
+
+        // Trama de los servos hardware, común a todos los timers de servo (prescaler 8)
+        static uint16_t hzTramaServo;
+        static uint16_t icrTramaServo;
 
         // Status del timer
         bool isInitialized = false;
+        // COMnx1 activo: el pin sigue la forma de onda del canal
+        volatile bool salidaConectada = false;
+
+        // PWM de uso general: modo, polaridad y reloj elegidos por iniciarPWM()
+        E_TIPO_PWM tipoPWM = E_TIPO_PWM::SERVO;
+        bool invertido = false;
+        S_RELOJ_TIMMER reloj{};
 
     public:
     // Constructor
@@ -80,8 +236,26 @@ class Timmer {
     };
 
     public:
-        // Método para inicializar el timer asociado al pin
-        bool initTimmer();
+        // Método para buscar el descriptor de canal OC de un pin (lectura desde flash)
+        static bool buscarCanalOC(uint8_t pin, S_CANAL_OC& canal);
+        // Método para inicializar el timer asociado al pin (pulso inicial en ticks; salida conectada o en bajo)
+        bool initTimmer(uint16_t ticksIniciales = TICKS_PULSO_INICIAL, bool conectar = true);
+        // Metodo para fijar la frecuencia de trama de los servos (50-400 Hz, antes de crear el primero)
+        static bool configurarTramaServo(uint16_t hz);
+        // Metodo para elegir el prescaler y el TOP de mayor resolucion para una frecuencia (false si no cabe)
+        static bool seleccionarReloj(uint32_t frecuenciaHz, bool faseCorrecta, S_RELOJ_TIMMER& reloj);
+        // Metodo para pasar una duracion en ms a tramas de servo (redondeo hacia arriba)
+        static uint16_t msATramas(uint32_t ms);
+        // Metodo para iniciar el canal como PWM de uso general (frecuencia en Hz, modo y polaridad)
+        bool iniciarPWM(uint32_t frecuenciaHz, E_TIPO_PWM tipo = E_TIPO_PWM::RAPIDO, bool invertido = false);
+        // Metodo para fijar el ciclo de trabajo de 16 bits (0 = apagado, 65535 = encendido)
+        bool escribirCiclo(uint16_t ciclo);
+        // Metodo para consultar la frecuencia real del PWM en Hz (0 si no es PWM de uso general)
+        uint32_t frecuenciaPWM() const;
+        // Metodo para conectar la salida OCnx (COMnx1:COMnx0 = 10, o 11 si la salida es invertida)
+        void conectarSalida();
+        // Metodo para desconectar la salida OCnx (COMnx1:COMnx0 = 00, el pin queda con el valor de PORT)
+        void desconectarSalida();
         // Metodo para visualizar configuracion
         void printTimmerConfig();
         // Metodo para visualizar los bits con ceros a la izquierda
@@ -0,0 +1,118 @@
+#ifndef TRAMA_TIMMER_H
+#define TRAMA_TIMMER_H
+
+#include "ServoSG90/timmer.h"
+
+/*
+    Actualización de OCRnx sincronizada con la trama PWM
+    -----------------------------------------------------------------------------------------------
+    En Fast PWM con TOP = ICRn el OCRnx tiene doble buffer: el valor escrito pasa al comparador en
+    BOTTOM, así que un pulso nunca se corta a mitad. Quedan dos riesgos:
+    - El byte alto del OCR pasa por el registro TEMP compartido del timer. Si una ISR accede a otro
+      registro de 16 bits entre los dos bytes, el valor se corrompe → escribirRegistro16Atomico().
+    - Varias escrituras seguidas pueden quedar a ambos lados de un BOTTOM y aplicarse en tramas
+      distintas.
+
+    Modo por trama: los ticks se dejan preparados en RAM y la ISR de desbordamiento (TOVn, en TOP)
+    los copia a los OCRnx del timer. Como la ISR entra después de BOTTOM, todos los valores de la
+    trama se aplican juntos en el siguiente BOTTOM (latencia fija de una trama, 20 ms a 50 Hz).
+
+    Ciclo:
+        TOP ── TOVn → ISR copia pendientes ── BOTTOM (OCRnx aplicados) ── pulso ── TOP ...
+
+    Tareas de trama: antes de copiar los pendientes la ISR ejecuta las tareas registradas con
+    agregarTarea() (p. ej. PlanificadorServo), que dejan preparado el valor de la trama siguiente.
+    La librería usa 6 de los MAX_TAREAS_TRAMA huecos (arranque, reposo, planificador, coordinador,
+    animación, cinemática). Con la tabla llena agregarTarea() devuelve false y el módulo lo propaga:
+    programar()/configurarReposo() dan false, y un planificador, coordinador, reproductor o
+    cinemática queda con registrado = false y rechaza moverA()/agregar().
+
+    Dithering temporal: prepararOCRQ8() deja una consigna en ticks Q8 (ticks × 256). confirmar()
+    alterna OCRnx entre ticks y ticks + 1 con un sigma-delta de primer orden:
+
+        error += fraccion;  OCRnx = ticks + acarreo     (error y fraccion de 8 bits)
+
+    La media del pulso sigue la consigna con 1/256 de tick (≈ 2 ns) en lugar de 0.5 µs: en una
+    rampa lenta el servo recibe la posición intermedia en vez de escalones de un tick. Coste
+    acotado: una suma y una escritura de 16 bits por canal con fracción, como mucho 3 por ISR.
+    Un valor sin fracción (prepararOCR, ServoGroup, coordinador, animación) termina el dithering
+    del canal. Con fracciones cercanas a 0 o 1 el patrón es lento (un tick extra cada 1/f tramas).
+*/
+
+enum class E_MODO_ACTUALIZACION {
+    DIRECTO = 0,     // Escritura atómica inmediata en OCRnx
+    TRAMA   = 1,     // Preparado en RAM y confirmado desde TIMERn_OVF
+};
+
+constexpr uint8_t NUM_TIMMERS          = 6;   // Indexado por E_TIMMER_ASCIOADO (0..5)
+constexpr uint8_t NUM_CANALES_TIMMER   = 3;   // Canales A, B, C de un timer de 16 bits
+constexpr uint8_t MAX_TAREAS_TRAMA     = 8;   // Tareas ejecutadas al inicio de cada trama (6 de la librería + 2 libres)
+
+// Tarea de inicio de trama: se llama desde la ISR TOVn, antes de confirmar los pendientes
+typedef void (*F_TAREA_TRAMA)(E_TIMMER_ASCIOADO timmer);
+
+// Valores pendientes de un timer de 16 bits
+struct S_TRAMA_TIMMER {
+    volatile uint16_t ticks[NUM_CANALES_TIMMER];    // Índice 0 = OCRnA, 1 = OCRnB, 2 = OCRnC
+    volatile uint8_t  pendientes;                   // Bit k = canal k pendiente
+    volatile uint8_t  fraccion[NUM_CANALES_TIMMER]; // Fracción de tick (Q8) de cada canal
+    uint8_t           error[NUM_CANALES_TIMMER];    // Error acumulado del sigma-delta
+    volatile uint8_t  conFraccion;                  // Bit k = el pendiente del canal k trae fracción
+    volatile uint8_t  dithering;                    // Bit k = canal k con dithering en curso
+};
+
+class TramaTimmer {
+public :
+    // Estado de cada timer (indexado por E_TIMMER_ASCIOADO)
+    static S_TRAMA_TIMMER tramas[NUM_TIMMERS];
+    // Tareas de inicio de trama (planificadores de movimiento)
+    static F_TAREA_TRAMA tareas[MAX_TAREAS_TRAMA];
+    static uint8_t numTareas;
+
+public :
+    // Metodo para habilitar la interrupcion TOVn del timer del canal
+    static void habilitar(const S_CANAL_OC& canal);
+    // Metodo para dejar preparado el valor de un canal (se aplica en la siguiente trama)
+    static void prepararOCR(const S_CANAL_OC& canal, uint16_t ticks);
+    // Metodo para dejar preparado un valor en ticks Q8 (con fraccion: dithering desde la siguiente trama)
+    static void prepararOCRQ8(const S_CANAL_OC& canal, uint32_t ticksQ8);
+    // Metodo para saber si un timer tiene valores sin confirmar
+    static bool hayPendientes(E_TIMMER_ASCIOADO timmer);
+    // Metodo para registrar una tarea de inicio de trama (una sola vez por funcion)
+    static bool agregarTarea(F_TAREA_TRAMA tarea);
+
+    // Ejecuta las tareas registradas. Llamado desde la ISR antes de confirmar()
+    static inline void ejecutarTareas(E_TIMMER_ASCIOADO timmer) {
+        for (uint8_t i = 0; i < numTareas; i++) tareas[i](timmer);
+    }
+
+    // Índice del canal dentro del timer: OCRnA/B/C están a continuación de ICRn
+    static inline uint8_t indiceCanal(const S_CANAL_OC& canal) {
+        return (canal.dirOCR - canal.dirICR - 2) >> 1;
+    }
+
+    // Copia los pendientes a OCRnA/B/C y aplica el dithering. Llamado desde la ISR (interrupciones deshabilitadas)
+    static inline void confirmar(S_TRAMA_TIMMER& trama, uint16_t dirOCRA) {
+        uint8_t pendientes = trama.pendientes;
+        if (pendientes) {
+            if (pendientes & 0x01) _SFR_MEM16(dirOCRA)     = trama.ticks[0];
+            if (pendientes & 0x02) _SFR_MEM16(dirOCRA + 2) = trama.ticks[1];
+            if (pendientes & 0x04) _SFR_MEM16(dirOCRA + 4) = trama.ticks[2];
+            trama.dithering   = (trama.dithering & ~pendientes) | (trama.conFraccion & pendientes);
+            trama.conFraccion = 0;
+            trama.pendientes  = 0;
+        }
+
+        // Sigma-delta: el acarreo del error suma un tick en la proporción fraccion / 256
+        uint8_t dithering = trama.dithering;
+        if (!dithering) return;
+        for (uint8_t k = 0; k < NUM_CANALES_TIMMER; k++) {
+            if (!(dithering & (1 << k))) continue;
+            uint16_t suma = trama.error[k] + trama.fraccion[k];
+            trama.error[k] = (uint8_t)suma;
+            _SFR_MEM16(dirOCRA + 2 * k) = trama.ticks[k] + (suma >> 8);
+        }
+    }
+};
+
+#endif /* TRAMA_TIMMER_H */
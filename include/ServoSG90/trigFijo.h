@@ -0,0 +1,64 @@
+#ifndef TRIG_FIJO_H
+#define TRIG_FIJO_H
+
+#include <Arduino.h>
+
+/*
+    TrigFijo: seno, coseno, atan2 y raíz cuadrada en punto fijo (sin float)
+    -----------------------------------------------------------------------------------------------
+    sin()/atan2() de avr-libc usan float por software: miles de ciclos por llamada, imposible dentro
+    de la trama de 20 ms con varias articulaciones. Formatos:
+
+        Ángulo   BAM16 (uint16_t): 65536 = 360°, 0x4000 = 90°. El desbordamiento es la vuelta.
+        Seno     Q15 (int16_t): 32767 ≈ 1.0
+
+    - seno/coseno: tabla en flash de un cuarto de onda (257 entradas Q15) e interpolación lineal
+      con una multiplicación 8×16. Error ≈ 1 LSB Q15.
+    - atan2: CORDIC en modo vectorización, 16 iteraciones con sumas y desplazamientos de 32 bits y
+      una tabla atan(2^-i) en flash. La entrada se normaliza a 2^28..2^29 para no perder bits ni
+      desbordar (ganancia CORDIC 1.647). Error ≤ 2 BAM (≈ 0.01°).
+    - raizCuadrada: método bit a bit (16 iteraciones, sin división).
+
+    La precisión frente a libm se comprueba en el PC (test/test_trigFijo, pio test -e native).
+    Ciclos estimados a mano, no medidos (README, "Cycle cost"): seno/coseno ≈ 70–100, atan2
+    ≈ 2300–2900 (desplazamientos variables de 32 bits), raizCuadrada ≈ 250–650.
+
+    Ejemplo:
+        int16_t s = TrigFijo::seno(TrigFijo::gradosQ8ABam(30 << 8));     // ≈ 16384
+        uint16_t a = TrigFijo::atan2(100, 100);                          // 0x2000 (45°)
+*/
+
+constexpr uint16_t BAM_90               = 0x4000;
+constexpr uint16_t BAM_180              = 0x8000;
+constexpr uint16_t PASOS_TABLA_SENO     = 256;    // Intervalos de 0° a 90°
+constexpr uint8_t  ITERACIONES_CORDIC   = 16;
+constexpr int16_t  UNO_Q15              = 32767;
+
+extern const int16_t  TABLA_SENO_Q15[PASOS_TABLA_SENO + 1];
+extern const uint16_t TABLA_ATAN_CORDIC[ITERACIONES_CORDIC];
+
+class TrigFijo {
+public :
+    // Metodo para calcular el seno de un angulo BAM16 (resultado Q15)
+    static int16_t seno(uint16_t angulo);
+    // Metodo para calcular el coseno de un angulo BAM16 (resultado Q15)
+    static int16_t coseno(uint16_t angulo);
+    // Metodo para calcular el angulo BAM16 del vector (x, y) (0 = eje +x, sentido antihorario)
+    static uint16_t atan2(int32_t y, int32_t x);
+    // Metodo para calcular la raiz cuadrada entera (por defecto)
+    static uint16_t raizCuadrada(uint32_t x);
+    // Metodo para calcular el modulo del vector (x, y)
+    static uint16_t hipotenusa(int16_t x, int16_t y);
+
+    // Grados Q8 (0-360°) → BAM16: × 65536 / 92160 ≈ × 23302 / 2^15
+    static inline uint16_t gradosQ8ABam(uint32_t gradosQ8) {
+        return (uint16_t)((gradosQ8 * 23302UL + 16384UL) >> 15);
+    }
+
+    // BAM16 → grados Q8 (0-360°): × 92160 / 65536 = × 45 / 32
+    static inline uint32_t bamAGradosQ8(uint16_t angulo) {
+        return ((uint32_t)angulo * 45UL + 16) >> 5;
+    }
+};
+
+#endif /* TRIG_FIJO_H */
@@ -10,6 +10,19 @@
 #include "system/pinout/pinout.h"                                   // Pinout definitions
 #include "ServoSG90/servo.h"                                        // Servo motor control
 #include "ServoSG90/timmer.h"                                       // Timer configuration for PWM
+#include "ServoSG90/arranque.h"                                     // Startup policy and staggered output connection
+#include "ServoSG90/calibracion.h"                                  // Per-servo calibration profiles in EEPROM (CRC16)
+#include "ServoSG90/servoPin.h"                                     // Servo motor resolved at compile time
+#include "ServoSG90/servoGroup.h"                                   // Servos updated in the same PWM frame
+#include "ServoSG90/servoMultiplex.h"                                // Up to 48 software-multiplexed servos on Timer5
+#include "ServoSG90/servo8Bits.h"                                    // Servos on 8-bit Timer0/Timer2 pins (4, 9, 10, 13)
+#include "ServoSG90/gestorTimmers.h"                                 // Timer ownership registry
+#include "ServoSG90/sincronizador.h"                                 // Phase-staggered frame start across servo timers
+#include "ServoSG90/planificador.h"                                  // Trapezoidal motion planner (frame ISR)
+#include "ServoSG90/coordinador.h"                                   // Multi-axis moves with synchronized arrival
+#include "ServoSG90/trigFijo.h"                                      // Fixed-point sin/cos/atan2/sqrt (no float)
+#include "ServoSG90/cinematica.h"                                    // On-board inverse kinematics (2/3 DOF)
+#include "ServoSG90/animacion.h"                                     // Keyframe animations played from flash
 
 // Firmware metadata =============================================================================================================================
 #define FIRMWARE_VERSION                 "1.0.B"                                    // Firmware version
@@ -0,0 +1,170 @@
+#include "ServoSG90/animacion.h"
+
+ReproductorAnimacion* ReproductorAnimacion::reproductores[MAX_ANIMACIONES];
+uint8_t               ReproductorAnimacion::numReproductores = 0;
+
+
+// Constructor: registra el reproductor en la lista de tareas de trama
+ReproductorAnimacion::ReproductorAnimacion() {
+    if (numReproductores >= MAX_ANIMACIONES) return;
+    if (!TramaTimmer::agregarTarea(avanzarTrama)) return;
+
+    ATOMIC_BLOCK(ATOMIC_RESTORESTATE) {
+        reproductores[numReproductores++] = this;
+    }
+    this->registrado = true;
+}
+
+// Metodo para añadir un servo inicializado (pasa a modo de actualizacion por trama)
+bool ReproductorAnimacion::agregar(ServoMotor& servo) {
+    if (!this->registrado) return false;
+    if (this->numServos >= MAX_SERVOS_ANIMACION) return false;
+    if (!servo.ServoInicializado) return false;
+    if (this->reproduciendo) return false;
+
+    const S_CANAL_OC& canal = servo.timmerServo.canal;
+    uint8_t k = TramaTimmer::indiceCanal(canal);
+
+    S_MIEMBRO_GRUPO& m = this->miembros[this->numServos];
+    m.servo    = &servo;
+    m.trama    = &TramaTimmer::tramas[static_cast<uint8_t>(canal.timmer)];
+    m.indice   = k;
+    m.bitCanal = (1 << k);
+
+    ATOMIC_BLOCK(ATOMIC_RESTORESTATE) {
+        if (this->numServos == 0) this->timmerMaestro = canal.timmer;
+        this->numServos++;
+    }
+
+    // TOVn habilitada también en los timers que no son el maestro (confirman sus OCR)
+    servo.configurarModoActualizacion(E_MODO_ACTUALIZACION::TRAMA);
+    return true;
+}
+
+// Metodo para arrancar la reproduccion desde el primer fotograma
+bool ReproductorAnimacion::iniciar(const uint8_t* animacion, uint16_t num, uint8_t tamano, bool enBucle) {
+    if (animacion == nullptr || num == 0 || this->numServos == 0) return false;
+
+    detener();
+    this->fotogramas      = animacion;
+    this->numFotogramas   = num;
+    this->tamanoFotograma = tamano;
+    this->bucle           = enBucle;
+
+    // El primer tramo parte de la última consigna de cada servo (con la rampa de arranque ya anulada)
+    for (uint8_t i = 0; i < this->numServos; i++) {
+        this->miembros[i].servo->reconectarSiPendiente();
+        this->actuales[i] = this->miembros[i].servo->timmerServo.registroOCRData;
+    }
+
+    ATOMIC_BLOCK(ATOMIC_RESTORESTATE) {
+        cargarFotograma(0);
+        this->reproduciendo = true;
+    }
+    return true;
+}
+
+// Metodo para detener la reproduccion en la consigna actual
+void ReproductorAnimacion::detener() {
+    bool estaba;
+    ATOMIC_BLOCK(ATOMIC_RESTORESTATE) {
+        estaba = this->reproduciendo;
+        this->reproduciendo = false;
+    }
+    if (!estaba) return;
+
+    // Estado informativo de cada servo
+    for (uint8_t i = 0; i < this->numServos; i++) {
+        this->miembros[i].servo->timmerServo.registroOCRData = this->actuales[i];
+    }
+}
+
+// Metodo para leer el fotograma en curso
+uint16_t ReproductorAnimacion::fotogramaActual() {
+    uint16_t k;
+    ATOMIC_BLOCK(ATOMIC_RESTORESTATE) {
+        k = this->indice;
+    }
+    return k;
+}
+
+// Lee un fotograma de flash y prepara el tramo desde la consigna actual
+void ReproductorAnimacion::cargarFotograma(uint16_t k) {
+    const uint8_t* f = this->fotogramas + (uint16_t)k * this->tamanoFotograma;
+    uint16_t duracion = pgm_read_word(f + OFFSET_DURACION_FOTOGRAMA);
+
+    for (uint8_t i = 0; i < this->numServos; i++) {
+        uint8_t angulo = pgm_read_byte(f + OFFSET_ANGULOS_FOTOGRAMA + i);
+        this->desde[i] = this->actuales[i];
+        this->hasta[i] = this->miembros[i].servo->ticksDeAngulo(angulo);
+    }
+
+    // Tramas del tramo (mínimo una: duración 0 salta a la pose)
+    uint16_t tramas = Timmer::msATramas(duracion);
+    if (tramas == 0) tramas = 1;
+
+    this->indice          = k;
+    this->suavizado       = static_cast<E_SUAVIZADO>(pgm_read_byte(f + OFFSET_SUAVIZADO_FOTOGRAMA));
+    this->tramasRestantes = tramas;
+    this->progreso        = 0;
+    this->incremento      = 0x10000UL / tramas;
+    this->resto           = 0x10000UL % tramas;
+    this->acumuladoResto  = 0;
+    this->tramasTramo     = tramas;
+}
+
+// Avanza una trama y deja preparados los OCR de todos los servos (interrupciones deshabilitadas)
+void ReproductorAnimacion::avanzar() {
+    if (!this->reproduciendo) return;
+
+    this->tramasRestantes--;
+    bool finTramo = (this->tramasRestantes == 0);
+    this->progreso += this->incremento;
+    this->acumuladoResto += this->resto;
+    if (this->acumuladoResto >= this->tramasTramo) {
+        // Resto de 65536 / tramas: sin él la última trama saltaría a la pose
+        this->acumuladoResto -= this->tramasTramo;
+        this->progreso++;
+    }
+    uint16_t s = finTramo ? 0 : Suavizado::aplicar(this->suavizado, (uint16_t)this->progreso);
+
+    for (uint8_t i = 0; i < this->numServos; i++) {
+        uint16_t t;
+        if (finTramo) {
+            t = this->hasta[i];
+        } else {
+            int32_t delta = (int32_t)this->hasta[i] - this->desde[i];
+            t = this->desde[i] + (int16_t)((delta * s) >> 16);
+        }
+        this->actuales[i] = t;
+
+        S_MIEMBRO_GRUPO& m = this->miembros[i];
+        m.trama->ticks[m.indice] = t;
+        m.trama->conFraccion &= ~m.bitCanal;
+        m.trama->pendientes |= m.bitCanal;
+    }
+    if (!finTramo) return;
+
+    // Siguiente fotograma (o vuelta al primero en bucle)
+    uint16_t siguiente = this->indice + 1;
+    if (siguiente >= this->numFotogramas) {
+        if (!this->bucle) {
+            this->reproduciendo = false;
+            for (uint8_t i = 0; i < this->numServos; i++) {
+                this->miembros[i].servo->timmerServo.registroOCRData = this->actuales[i];
+            }
+            return;
+        }
+        siguiente = 0;
+    }
+    cargarFotograma(siguiente);
+}
+
+// Tarea de trama: avanza los reproductores del timer maestro (desde la ISR TOVn)
+void ReproductorAnimacion::avanzarTrama(E_TIMMER_ASCIOADO timmer) {
+    for (uint8_t i = 0; i < numReproductores; i++) {
+        ReproductorAnimacion* r = reproductores[i];
+        if (r->numServos == 0 || r->timmerMaestro != timmer) continue;
+        r->avanzar();
+    }
+}
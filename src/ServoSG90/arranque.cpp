@@ -0,0 +1,218 @@
+#include "ServoSG90/arranque.h"
+#include "ServoSG90/servo.h"
+
+S_CONEXION_PENDIENTE ArranqueServos::pendientes[MAX_CONEXIONES_PENDIENTES];
+uint8_t              ArranqueServos::intervaloTramas = TRAMAS_ESCALONADO_DEFECTO;
+S_RAMPA_ARRANQUE     ArranqueServos::rampas[MAX_CONEXIONES_PENDIENTES];
+uint8_t              ArranqueServos::ticksRampa = TICKS_RAMPA_DEFECTO;
+
+static_assert(DIRECCION_POSICIONES_EEPROM >= DIRECCION_CALIBRACION_EEPROM + sizeof(S_CABECERA_CALIBRACION) +
+              sizeof(CalibracionServos::tabla) + sizeof(uint16_t), "Las posiciones pisan la calibracion");
+static_assert(DIRECCION_POSICIONES_EEPROM + sizeof(S_POSICIONES_GUARDADAS) <= E2END + 1,
+              "Las posiciones no caben en la EEPROM");
+
+
+// Metodo para fijar las tramas entre dos conexiones escalonadas (antes de crear los servos)
+void ArranqueServos::configurarIntervalo(uint8_t tramas) {
+    intervaloTramas = (tramas == 0) ? 1 : tramas;
+}
+
+// Metodo para fijar el paso de la rampa de arranque en ticks por trama
+void ArranqueServos::configurarRampa(uint8_t ticksPorTrama) {
+    ticksRampa = (ticksPorTrama == 0) ? 1 : ticksPorTrama;
+}
+
+// Metodo para conectar la salida de un canal dentro de n tramas (1 = siguiente trama)
+bool ArranqueServos::programar(Timmer& timmer, uint16_t tramas) {
+    if (!timmer.isInitialized) return false;
+    if (tramas == 0) tramas = 1;
+    // La tarea corre en la ISR TOVn del timer del canal: sin ella la conexión no llegaría nunca
+    if (!TramaTimmer::agregarTarea(avanzarTrama)) return false;
+
+    // Un canal ya programado solo cambia de turno; si no, ocupa el primer hueco libre
+    int8_t hueco = -1;
+    bool programado = false;
+    ATOMIC_BLOCK(ATOMIC_RESTORESTATE) {
+        for (uint8_t i = 0; i < MAX_CONEXIONES_PENDIENTES; i++) {
+            if (pendientes[i].timmer == &timmer) { pendientes[i].tramas = tramas; programado = true; break; }
+            if (pendientes[i].timmer == nullptr && hueco < 0) hueco = i;
+        }
+        if (!programado && hueco >= 0) {
+            pendientes[hueco].tramas = tramas;
+            pendientes[hueco].timmer = &timmer;
+            programado = true;
+        }
+    }
+    if (!programado) return false;
+
+    TramaTimmer::habilitar(timmer.canal);
+    return true;
+}
+
+// Metodo para conectar la salida de un canal intervaloTramas después de la última pendiente
+bool ArranqueServos::programarEscalonado(Timmer& timmer) {
+    uint16_t ultima = 0;
+    ATOMIC_BLOCK(ATOMIC_RESTORESTATE) {
+        for (uint8_t i = 0; i < MAX_CONEXIONES_PENDIENTES; i++) {
+            if (pendientes[i].timmer != nullptr && pendientes[i].timmer != &timmer &&
+                pendientes[i].tramas > ultima) {
+                ultima = pendientes[i].tramas;
+            }
+        }
+    }
+
+    // El primero se conecta en la siguiente trama; cada uno de los demás, un intervalo después
+    return programar(timmer, (ultima == 0) ? 1 : ultima + intervaloTramas);
+}
+
+// Metodo para anular la conexion pendiente de un canal
+void ArranqueServos::cancelar(Timmer& timmer) {
+    ATOMIC_BLOCK(ATOMIC_RESTORESTATE) {
+        for (uint8_t i = 0; i < MAX_CONEXIONES_PENDIENTES; i++) {
+            if (pendientes[i].timmer == &timmer) pendientes[i].timmer = nullptr;
+        }
+    }
+}
+
+// Metodo para saber si un canal tiene la conexion programada
+bool ArranqueServos::pendiente(const Timmer& timmer) {
+    bool hay = false;
+    ATOMIC_BLOCK(ATOMIC_RESTORESTATE) {
+        for (uint8_t i = 0; i < MAX_CONEXIONES_PENDIENTES; i++) {
+            if (pendientes[i].timmer == &timmer) { hay = true; break; }
+        }
+    }
+    return hay;
+}
+
+// Metodo para saber si quedan salidas por conectar
+bool ArranqueServos::hayPendientes() {
+    bool hay = false;
+    ATOMIC_BLOCK(ATOMIC_RESTORESTATE) {
+        for (uint8_t i = 0; i < MAX_CONEXIONES_PENDIENTES; i++) {
+            if (pendientes[i].timmer != nullptr) { hay = true; break; }
+        }
+    }
+    return hay;
+}
+
+// Metodo para llevar la consigna de un canal conectado hasta objetivo a ticksRampa por trama
+bool ArranqueServos::programarRampa(Timmer& timmer, uint16_t objetivo) {
+    if (!timmer.isInitialized) return false;
+    // Misma tarea que las conexiones: un solo hueco de la tabla de TramaTimmer
+    if (!TramaTimmer::agregarTarea(avanzarTrama)) return false;
+
+    int8_t hueco = -1;
+    bool programada = false;
+    ATOMIC_BLOCK(ATOMIC_RESTORESTATE) {
+        for (uint8_t i = 0; i < MAX_CONEXIONES_PENDIENTES; i++) {
+            if (rampas[i].timmer == &timmer) { rampas[i].objetivo = objetivo; programada = true; break; }
+            if (rampas[i].timmer == nullptr && hueco < 0) hueco = i;
+        }
+        if (!programada && hueco >= 0) {
+            rampas[hueco].objetivo = objetivo;
+            rampas[hueco].timmer = &timmer;
+            programada = true;
+        }
+    }
+    if (!programada) return false;
+
+    TramaTimmer::habilitar(timmer.canal);
+    return true;
+}
+
+// Metodo para anular la rampa de un canal (la consigna queda donde llegó)
+void ArranqueServos::cancelarRampa(Timmer& timmer) {
+    ATOMIC_BLOCK(ATOMIC_RESTORESTATE) {
+        for (uint8_t i = 0; i < MAX_CONEXIONES_PENDIENTES; i++) {
+            if (rampas[i].timmer == &timmer) rampas[i].timmer = nullptr;
+        }
+    }
+}
+
+// Metodo para saber si queda alguna rampa de arranque en curso
+bool ArranqueServos::hayRampas() {
+    bool hay = false;
+    ATOMIC_BLOCK(ATOMIC_RESTORESTATE) {
+        for (uint8_t i = 0; i < MAX_CONEXIONES_PENDIENTES; i++) {
+            if (rampas[i].timmer != nullptr) { hay = true; break; }
+        }
+    }
+    return hay;
+}
+
+// Metodo para leer la posición guardada de un pin en ticks (0 si no hay imagen válida o posición)
+uint16_t ArranqueServos::posicionGuardada(uint8_t pin) {
+    if (pin >= NUM_PINES_CANAL_OC) return 0;
+    uint8_t i = pgm_read_byte(&TABLA_PIN_CANAL.indice[pin]);
+    if (i == SIN_CANAL_OC) return 0;
+
+    S_POSICIONES_GUARDADAS imagen;
+    if (!leerPosiciones(imagen)) return 0;
+    return imagen.ticks[i];
+}
+
+// Metodo para guardar la consigna actual de los servos creados (solo escribe los bytes que cambian)
+void ArranqueServos::guardarPosiciones() {
+    // Los canales sin servo creado conservan lo que hubiera guardado
+    S_POSICIONES_GUARDADAS imagen;
+    if (!leerPosiciones(imagen)) {
+        for (uint8_t i = 0; i < NUM_CANALES_OC; i++) imagen.ticks[i] = 0;
+    }
+
+    for (uint8_t i = 0; i < NUM_CANALES_OC; i++) {
+        ServoMotor* s = CalibracionServos::servos[i];
+        if (s == nullptr || !s->ServoInicializado) continue;
+        ATOMIC_BLOCK(ATOMIC_RESTORESTATE) {
+            imagen.ticks[i] = s->timmerServo.registroOCRData;
+        }
+    }
+    imagen.firma = FIRMA_POSICIONES;
+    imagen.crc = calcularCRC(imagen);
+
+    // Bloqueante: ~3.4 ms por byte que cambia
+    eeprom_update_block(&imagen, (void*)DIRECCION_POSICIONES_EEPROM, sizeof(imagen));
+}
+
+// Tarea de trama: conecta las salidas del timer cuyo turno ha llegado (desde la ISR TOVn)
+void ArranqueServos::avanzarTrama(E_TIMMER_ASCIOADO timmer) {
+    for (uint8_t i = 0; i < MAX_CONEXIONES_PENDIENTES; i++) {
+        S_CONEXION_PENDIENTE& p = pendientes[i];
+        if (p.timmer == nullptr || p.timmer->canal.timmer != timmer) continue;
+        if (--p.tramas != 0) continue;
+
+        // Interrupciones ya deshabilitadas: el bloque atómico de conectarSalida solo las restaura
+        p.timmer->conectarSalida();
+        p.timmer = nullptr;
+    }
+
+    // Rampas de arranque: un paso por trama desde la consigna actual
+    for (uint8_t i = 0; i < MAX_CONEXIONES_PENDIENTES; i++) {
+        S_RAMPA_ARRANQUE& r = rampas[i];
+        if (r.timmer == nullptr || r.timmer->canal.timmer != timmer) continue;
+
+        int32_t actual = r.timmer->registroOCRData;
+        int32_t d = (int32_t)r.objetivo - actual;
+        if (d >  ticksRampa) d =  ticksRampa;
+        if (d < -ticksRampa) d = -ticksRampa;
+        uint16_t ticks = actual + d;
+
+        TramaTimmer::prepararOCR(r.timmer->canal, ticks);
+        r.timmer->registroOCRData = ticks;
+        if (ticks == r.objetivo) r.timmer = nullptr;
+    }
+}
+
+// Lee la imagen de EEPROM (false si firma o CRC no cuadran)
+bool ArranqueServos::leerPosiciones(S_POSICIONES_GUARDADAS& imagen) {
+    eeprom_read_block(&imagen, (const void*)DIRECCION_POSICIONES_EEPROM, sizeof(imagen));
+    return imagen.firma == FIRMA_POSICIONES && imagen.crc == calcularCRC(imagen);
+}
+
+// CRC16-CCITT de la firma y las consignas
+uint16_t ArranqueServos::calcularCRC(const S_POSICIONES_GUARDADAS& imagen) {
+    uint16_t crc = 0xFFFF;
+    const uint8_t* p = (const uint8_t*)&imagen;
+    for (uint8_t i = 0; i < sizeof(imagen) - sizeof(imagen.crc); i++) crc = _crc_ccitt_update(crc, p[i]);
+    return crc;
+}
@@ -0,0 +1,221 @@
+#include "ServoSG90/calibracion.h"
+#include "ServoSG90/servo.h"
+
+S_CALIBRACION_SERVO CalibracionServos::tabla[NUM_CANALES_OC];
+ServoMotor*         CalibracionServos::servos[NUM_CANALES_OC];
+bool                CalibracionServos::cargada = false;
+char                CalibracionServos::linea[LONGITUD_COMANDO_CALIBRACION];
+uint8_t             CalibracionServos::longitudLinea = 0;
+
+// Posiciones de la imagen en EEPROM
+constexpr uint16_t DIRECCION_PERFILES_EEPROM = DIRECCION_CALIBRACION_EEPROM + sizeof(S_CABECERA_CALIBRACION);
+constexpr uint16_t DIRECCION_CRC_EEPROM      = DIRECCION_PERFILES_EEPROM + sizeof(CalibracionServos::tabla);
+constexpr uint8_t  LINEA_DESCARTADA          = 0xFF;
+
+static_assert(sizeof(S_CALIBRACION_SERVO) == 8, "Perfil de calibracion de 8 bytes");
+static_assert(DIRECCION_CRC_EEPROM + sizeof(uint16_t) <= E2END + 1, "La calibracion no cabe en la EEPROM");
+
+
+// Metodo para leer los perfiles de EEPROM (false si no hay imagen valida: quedan los de defecto)
+bool CalibracionServos::cargar() {
+    S_CABECERA_CALIBRACION cabecera;
+    eeprom_read_block(&cabecera, (const void*)DIRECCION_CALIBRACION_EEPROM, sizeof(cabecera));
+    eeprom_read_block(tabla, (const void*)DIRECCION_PERFILES_EEPROM, sizeof(tabla));
+    uint16_t crc = eeprom_read_word((const uint16_t*)DIRECCION_CRC_EEPROM);
+
+    bool valida = cabecera.firma == FIRMA_CALIBRACION && cabecera.version == VERSION_CALIBRACION &&
+                  cabecera.numCanales == NUM_CANALES_OC && crc == calcularCRC(cabecera);
+    if (!valida) valoresPorDefecto();
+    cargada = true;
+
+    // Servos ya creados: cambian a su perfil (o vuelven a su tabla)
+    for (uint8_t i = 0; i < NUM_CANALES_OC; i++) {
+        if (servos[i] != nullptr) servos[i]->aplicarCalibracion(tabla[i]);
+    }
+    return valida;
+}
+
+// Metodo para guardar los perfiles en EEPROM (solo escribe los bytes que cambian)
+void CalibracionServos::guardar() {
+    S_CABECERA_CALIBRACION cabecera = { FIRMA_CALIBRACION, VERSION_CALIBRACION, NUM_CANALES_OC };
+
+    // Bloqueante: ~3.4 ms por byte que cambia
+    eeprom_update_block(&cabecera, (void*)DIRECCION_CALIBRACION_EEPROM, sizeof(cabecera));
+    eeprom_update_block(tabla, (void*)DIRECCION_PERFILES_EEPROM, sizeof(tabla));
+    eeprom_update_word((uint16_t*)DIRECCION_CRC_EEPROM, calcularCRC(cabecera));
+}
+
+// Metodo para dejar todos los canales sin calibrar (no toca la EEPROM)
+void CalibracionServos::valoresPorDefecto() {
+    for (uint8_t i = 0; i < NUM_CANALES_OC; i++) {
+        tabla[i] = { PULSO_MIN_US_SG90, PULSO_MAX_US_SG90, 0, 0, 0, ANGULO_MAX_SERVO };
+    }
+}
+
+// Metodo para asociar un servo a su canal y aplicarle su perfil (lo llama ServoMotor)
+bool CalibracionServos::registrar(ServoMotor* servo) {
+    uint8_t i = indiceCanal(servo->timmerServo.pinData);
+    if (i == SIN_CANAL_OC) return false;
+
+    // Primera carga al crear el primer servo (antes de su primer pulso)
+    if (!cargada) cargar();
+
+    servos[i] = servo;
+    return servo->aplicarCalibracion(tabla[i]);
+}
+
+// Metodo para cambiar el perfil de un canal y aplicarlo a su servo
+bool CalibracionServos::configurar(uint8_t pin, const S_CALIBRACION_SERVO& perfil) {
+    uint8_t i = indiceCanal(pin);
+    if (i == SIN_CANAL_OC) return false;
+    if (perfil.minUs >= perfil.maxUs || (int16_t)perfil.minUs + perfil.trimUs <= 0 ||
+        perfil.anguloMin > perfil.anguloMax || perfil.anguloMax > ANGULO_MAX_SERVO) return false;
+
+    // Se aplica antes de guardar: un perfil que el servo rechaza no llega a la tabla (ni a la EEPROM
+    // con el siguiente guardar()) y el servo vuelve al perfil anterior
+    if (servos[i] != nullptr && !servos[i]->aplicarCalibracion(perfil)) {
+        servos[i]->aplicarCalibracion(tabla[i]);
+        return false;
+    }
+    tabla[i] = perfil;
+    return true;
+}
+
+// Metodo para consultar el perfil de un pin (nullptr si no tiene canal OC)
+const S_CALIBRACION_SERVO* CalibracionServos::perfil(uint8_t pin) {
+    uint8_t i = indiceCanal(pin);
+    return (i == SIN_CANAL_OC) ? nullptr : &tabla[i];
+}
+
+// Metodo para atender los comandos de calibracion que haya en el puerto (no bloquea)
+void CalibracionServos::procesarComando(Stream& puerto) {
+    while (puerto.available() > 0) {
+        procesarCaracter((char)puerto.read(), puerto);
+    }
+}
+
+// Metodo para acumular un caracter; ejecuta el comando al llegar el fin de linea
+void CalibracionServos::procesarCaracter(char c, Print& salida) {
+    // Una línea demasiado larga se descarta entera (LINEA_DESCARTADA hasta el fin de línea)
+    if (c == '\r' || c == '\n') {
+        uint8_t n = longitudLinea;
+        longitudLinea = 0;
+        if (n == 0 || n == LINEA_DESCARTADA) return;
+        linea[n] = '\0';
+        ejecutar(linea, salida);
+        return;
+    }
+
+    if (longitudLinea == LINEA_DESCARTADA) return;
+    if (longitudLinea >= LONGITUD_COMANDO_CALIBRACION - 1) {
+        salida.println(F("cal: linea demasiado larga"));
+        longitudLinea = LINEA_DESCARTADA;
+        return;
+    }
+    linea[longitudLinea++] = c;
+}
+
+// Índice del canal de un pin en TABLA_CANALES_OC (SIN_CANAL_OC si no tiene)
+uint8_t CalibracionServos::indiceCanal(uint8_t pin) {
+    if (pin >= NUM_PINES_CANAL_OC) return SIN_CANAL_OC;
+    return pgm_read_byte(&TABLA_PIN_CANAL.indice[pin]);
+}
+
+// CRC16-CCITT de la cabecera y los perfiles
+uint16_t CalibracionServos::calcularCRC(const S_CABECERA_CALIBRACION& cabecera) {
+    uint16_t crc = 0xFFFF;
+    const uint8_t* p = (const uint8_t*)&cabecera;
+    for (uint8_t i = 0; i < sizeof(cabecera); i++) crc = _crc_ccitt_update(crc, p[i]);
+    p = (const uint8_t*)tabla;
+    for (uint8_t i = 0; i < sizeof(tabla); i++) crc = _crc_ccitt_update(crc, p[i]);
+    return crc;
+}
+
+// Ejecuta una línea completa
+void CalibracionServos::ejecutar(char* comando, Print& salida) {
+    char* orden = strtok(comando, " ");
+    if (orden == nullptr) return;
+
+    if (strcmp(orden, "guardar") == 0) {
+        guardar();
+        salida.println(F("cal: guardado en EEPROM"));
+        return;
+    }
+    if (strcmp(orden, "cargar") == 0) {
+        salida.println(cargar() ? F("cal: cargado de EEPROM") : F("cal: EEPROM sin calibracion, valores por defecto"));
+        return;
+    }
+    if (strcmp(orden, "cal") != 0) {
+        salida.println(F("cal: comando desconocido"));
+        return;
+    }
+
+    char* textoPin = strtok(nullptr, " ");
+    if (textoPin == nullptr) { salida.println(F("cal: falta el pin")); return; }
+    uint8_t pin = atoi(textoPin);
+    uint8_t i = indiceCanal(pin);
+    if (i == SIN_CANAL_OC) { salida.println(F("cal: pin sin canal OC")); return; }
+
+    char* campo = strtok(nullptr, " ");
+    if (campo == nullptr) { imprimirPerfil(pin, salida); return; }
+    char* valor1 = strtok(nullptr, " ");
+    char* valor2 = strtok(nullptr, " ");
+    int   v1 = valor1 ? atoi(valor1) : 0;
+
+    // El perfil parte del rango de la tabla actual del servo si el canal no estaba calibrado
+    S_CALIBRACION_SERVO p = tabla[i];
+    ServoMotor* servo = servos[i];
+    if (!(p.opciones & CALIBRACION_ACTIVA) && servo != nullptr) {
+        p.minUs = pgm_read_word(&servo->tablaTicks->ticks[0]) / TICKS_POR_US;
+        p.maxUs = pgm_read_word(&servo->tablaTicks->ticks[ANGULO_MAX_SERVO]) / TICKS_POR_US;
+    }
+    p.opciones |= CALIBRACION_ACTIVA;
+
+    // Ángulo al que se lleva el servo para ver el efecto del cambio
+    int16_t anguloPrueba = -1;
+    bool conValor = (valor1 != nullptr);
+
+    if (strcmp(campo, "min") == 0 && conValor) {
+        p.minUs = constrain(v1, PULSO_MIN_CALIBRACION_US, PULSO_MAX_CALIBRACION_US);
+        anguloPrueba = 0;
+    } else if (strcmp(campo, "max") == 0 && conValor) {
+        p.maxUs = constrain(v1, PULSO_MIN_CALIBRACION_US, PULSO_MAX_CALIBRACION_US);
+        anguloPrueba = ANGULO_MAX_SERVO;
+    } else if (strcmp(campo, "trim") == 0 && conValor) {
+        p.trimUs = constrain(v1, INT8_MIN, INT8_MAX);
+        anguloPrueba = ANGULO_MAX_SERVO / 2;
+    } else if (strcmp(campo, "inv") == 0 && conValor) {
+        if (v1) p.opciones |= CALIBRACION_INVERTIDA;
+        else    p.opciones &= ~CALIBRACION_INVERTIDA;
+        anguloPrueba = ANGULO_MAX_SERVO / 2;
+    } else if (strcmp(campo, "lim") == 0 && conValor && valor2 != nullptr) {
+        p.anguloMin = constrain(v1, 0, ANGULO_MAX_SERVO);
+        p.anguloMax = constrain(atoi(valor2), 0, ANGULO_MAX_SERVO);
+    } else if (strcmp(campo, "borrar") == 0) {
+        p = { PULSO_MIN_US_SG90, PULSO_MAX_US_SG90, 0, 0, 0, ANGULO_MAX_SERVO };
+    } else {
+        salida.println(F("cal: campo no valido (min|max|trim|inv|lim|borrar)"));
+        return;
+    }
+
+    if (!configurar(pin, p)) {
+        salida.println(F("cal: perfil no valido (min < max, min + trim > 0, limites 0-180)"));
+        return;
+    }
+    if (servo != nullptr && anguloPrueba >= 0) servo->movimientoAngulo(anguloPrueba);
+    imprimirPerfil(pin, salida);
+}
+
+// Muestra el perfil de un pin
+void CalibracionServos::imprimirPerfil(uint8_t pin, Print& salida) {
+    const S_CALIBRACION_SERVO& p = tabla[indiceCanal(pin)];
+
+    salida.print(F("cal "));           salida.print(pin);
+    if (!(p.opciones & CALIBRACION_ACTIVA)) { salida.println(F(": tabla en flash")); return; }
+    salida.print(F(": min "));         salida.print(p.minUs);
+    salida.print(F(" us, max "));      salida.print(p.maxUs);
+    salida.print(F(" us, trim "));     salida.print(p.trimUs);
+    salida.print(F(" us, inv "));      salida.print((p.opciones & CALIBRACION_INVERTIDA) ? 1 : 0);
+    salida.print(F(", lim "));         salida.print(p.anguloMin);
+    salida.print(F("-"));              salida.println(p.anguloMax);
+}
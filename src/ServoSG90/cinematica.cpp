@@ -0,0 +1,234 @@
+#include "ServoSG90/cinematica.h"
+
+CinematicaInversa* CinematicaInversa::cinematicas[MAX_CINEMATICAS];
+uint8_t            CinematicaInversa::numCinematicas = 0;
+
+
+// Constructor: longitudes de brazo y antebrazo en Q4 mm
+CinematicaInversa::CinematicaInversa(uint16_t longitudBrazo, uint16_t longitudAntebrazo)
+    : longitudBrazo(longitudBrazo), longitudAntebrazo(longitudAntebrazo)
+{
+    if (numCinematicas >= MAX_CINEMATICAS) return;
+    if (!TramaTimmer::agregarTarea(marcarTrama)) return;
+
+    ATOMIC_BLOCK(ATOMIC_RESTORESTATE) {
+        cinematicas[numCinematicas++] = this;
+    }
+    this->registrado = true;
+}
+
+// Metodo para añadir una articulacion (2 GDL: hombro, codo | 3 GDL: base, hombro, codo)
+bool CinematicaInversa::agregarArticulacion(ServoMotor& servo, uint16_t ceroQ8, bool invertida,
+                                            uint16_t minQ8, uint16_t maxQ8) {
+    if (!this->registrado) return false;
+    if (this->numArticulaciones >= MAX_ARTICULACIONES_IK) return false;
+    if (minQ8 > maxQ8 || maxQ8 > ((uint16_t)ANGULO_MAX_SERVO << 8)) return false;
+    if (!this->grupo.agregar(servo)) return false;
+
+    S_ARTICULACION_IK& a = this->articulaciones[this->numArticulaciones];
+    a.servo     = &servo;
+    a.ceroQ8    = ceroQ8;
+    a.invertida = invertida;
+    a.minQ8     = minQ8;
+    a.maxQ8     = maxQ8;
+
+    // La trama la marca el timer de la primera articulación
+    ATOMIC_BLOCK(ATOMIC_RESTORESTATE) {
+        if (this->numArticulaciones == 0) this->timmerMaestro = servo.timmerServo.canal.timmer;
+        this->numArticulaciones++;
+    }
+    return true;
+}
+
+// Convierte el ángulo de la articulación al del servo y lo limita
+bool CinematicaInversa::articulacionAServo(uint8_t indice, uint16_t angulo, uint16_t& servoQ8) {
+    const S_ARTICULACION_IK& a = this->articulaciones[indice];
+
+    // BAM16 con signo (±180°) → grados Q8 con signo: × 45 / 32
+    int32_t gradosQ8 = ((int32_t)(int16_t)angulo * 45) / 32;
+    int32_t q8 = (int32_t)a.ceroQ8 + (a.invertida ? -gradosQ8 : gradosQ8);
+
+    if (q8 < (int32_t)a.minQ8) { servoQ8 = a.minQ8; return false; }
+    if (q8 > (int32_t)a.maxQ8) { servoQ8 = a.maxQ8; return false; }
+    servoQ8 = (uint16_t)q8;
+    return true;
+}
+
+// Convierte el ángulo del servo (grados Q8) al de la articulación (BAM16 con signo)
+uint16_t CinematicaInversa::servoAArticulacion(uint8_t indice, uint16_t servoQ8) const {
+    const S_ARTICULACION_IK& a = this->articulaciones[indice];
+
+    // Grados Q8 con signo → BAM16: × 32 / 45 ≈ × 23302 / 2^15
+    int32_t gradosQ8 = (int32_t)servoQ8 - a.ceroQ8;
+    if (a.invertida) gradosQ8 = -gradosQ8;
+    return (uint16_t)((gradosQ8 * 23302L + 16384L) >> 15);
+}
+
+// Punto de la pose actual de los servos (cinemática directa)
+bool CinematicaInversa::cinematicaDirecta(S_PUNTO_IK& punto) const {
+    if (this->numArticulaciones < 2) return false;
+
+    bool tresEjes = (this->numArticulaciones == 3);
+    uint8_t k = tresEjes ? 1 : 0;
+    uint16_t hombro = servoAArticulacion(k,     this->articulaciones[k].servo->anguloQ8Actual());
+    uint16_t codo   = servoAArticulacion(k + 1, this->articulaciones[k + 1].servo->anguloQ8Actual());
+
+    int32_t r, z;
+    CinematicaPlano::directa(this->longitudBrazo, this->longitudAntebrazo, hombro, codo, r, z);
+
+    punto.z = (int16_t)z;
+    if (!tresEjes) {
+        punto.x = (int16_t)r;
+        punto.y = 0;
+        return true;
+    }
+
+    uint16_t base = servoAArticulacion(0, this->articulaciones[0].servo->anguloQ8Actual());
+    punto.x = (int16_t)((r * TrigFijo::coseno(base) + 16384L) >> 15);
+    punto.y = (int16_t)((r * TrigFijo::seno(base)   + 16384L) >> 15);
+    return true;
+}
+
+// Metodo para calcular los angulos de servo (grados Q8) de un punto sin mover nada
+E_RESULTADO_IK CinematicaInversa::resolver(const S_PUNTO_IK& punto, uint16_t* angulosQ8) {
+    if (this->numArticulaciones < 2 ||
+        this->longitudBrazo == 0 || this->longitudBrazo > COORDENADA_MAX_IK ||
+        this->longitudAntebrazo == 0 || this->longitudAntebrazo > COORDENADA_MAX_IK) {
+        return E_RESULTADO_IK::SIN_CONFIGURAR;
+    }
+    if (punto.x > COORDENADA_MAX_IK || punto.x < -COORDENADA_MAX_IK ||
+        punto.y > COORDENADA_MAX_IK || punto.y < -COORDENADA_MAX_IK ||
+        punto.z > COORDENADA_MAX_IK || punto.z < -COORDENADA_MAX_IK) {
+        return E_RESULTADO_IK::FUERA_DE_ALCANCE;
+    }
+
+    bool tresEjes = (this->numArticulaciones == 3);
+    int16_t r = tresEjes ? (int16_t)TrigFijo::hipotenusa(punto.x, punto.y) : punto.x;
+
+    uint16_t hombro, codo;
+    if (!CinematicaPlano::inversa(this->longitudBrazo, this->longitudAntebrazo, this->codoArriba,
+                                  r, punto.z, hombro, codo)) {
+        return E_RESULTADO_IK::FUERA_DE_ALCANCE;
+    }
+
+    bool dentro = true;
+    uint8_t k = 0;
+    if (tresEjes) {
+        if (punto.x == 0 && punto.y == 0) {
+            // Sobre el eje z la base no está definida: se mantiene el ángulo actual del servo
+            angulosQ8[k] = this->articulaciones[0].servo->anguloQ8Actual();
+        } else {
+            dentro &= articulacionAServo(k, TrigFijo::atan2(punto.y, punto.x), angulosQ8[k]);
+        }
+        k++;
+    }
+    dentro &= articulacionAServo(k, hombro, angulosQ8[k]);
+    k++;
+    dentro &= articulacionAServo(k, codo, angulosQ8[k]);
+
+    return dentro ? E_RESULTADO_IK::OK : E_RESULTADO_IK::LIMITADO;
+}
+
+// Escribe los ángulos de servo en todas las articulaciones (misma trama)
+void CinematicaInversa::aplicar(const uint16_t* angulosQ8) {
+    uint16_t ticks[MAX_ARTICULACIONES_IK];
+    for (uint8_t i = 0; i < this->numArticulaciones; i++) {
+        ServoMotor* s = this->articulaciones[i].servo;
+        ticks[i] = s->ticksDeAnguloQ8(angulosQ8[i]);
+        s->angle = angulosQ8[i] >> 8;
+    }
+    this->grupo.escribirTicks(ticks, this->numArticulaciones);
+}
+
+// Metodo para llevar el brazo a un punto en la siguiente trama
+E_RESULTADO_IK CinematicaInversa::moverA(const S_PUNTO_IK& punto) {
+    uint16_t angulosQ8[MAX_ARTICULACIONES_IK];
+    E_RESULTADO_IK resultado = resolver(punto, angulosQ8);
+    this->ultimoResultado = resultado;
+    if (resultado == E_RESULTADO_IK::FUERA_DE_ALCANCE || resultado == E_RESULTADO_IK::SIN_CONFIGURAR) {
+        return resultado;
+    }
+
+    this->moviendo = false;
+    this->actual = punto;
+    this->poseConocida = true;
+    aplicar(angulosQ8);
+    return resultado;
+}
+
+// Metodo para recorrer la recta hasta un punto a velocidadMmS (mm/s), avanzado por actualizar()
+E_RESULTADO_IK CinematicaInversa::moverLineal(const S_PUNTO_IK& punto, uint16_t velocidadMmS) {
+    // Solo se comprueba el destino; los puntos intermedios se comprueban en cada trama
+    uint16_t angulosQ8[MAX_ARTICULACIONES_IK];
+    E_RESULTADO_IK resultado = resolver(punto, angulosQ8);
+    this->ultimoResultado = resultado;
+    if (resultado == E_RESULTADO_IK::FUERA_DE_ALCANCE || resultado == E_RESULTADO_IK::SIN_CONFIGURAR) {
+        return resultado;
+    }
+
+    // Sin punto enviado todavía: la recta parte de la pose de los servos, no del origen
+    if (!this->poseConocida) {
+        if (!cinematicaDirecta(this->actual)) return E_RESULTADO_IK::SIN_CONFIGURAR;
+        this->poseConocida = true;
+    }
+
+    int32_t dx = (int32_t)punto.x - this->actual.x;
+    int32_t dy = (int32_t)punto.y - this->actual.y;
+    int32_t dz = (int32_t)punto.z - this->actual.z;
+    uint32_t total = TrigFijo::raizCuadrada((uint32_t)(dx * dx) + (uint32_t)(dy * dy) + (uint32_t)(dz * dz));
+
+    // mm/s → Q4 mm/trama: × 16 / hz
+    uint32_t hz = Timmer::hzTramaServo;
+    uint32_t v = ((uint32_t)velocidadMmS * 16 + hz / 2) / hz;
+    if (v == 0) v = 1;
+    if (v > 0xFFFF) v = 0xFFFF;
+
+    this->inicio = this->actual;
+    this->destino = punto;
+    this->recorridoTotal = (uint16_t)total;
+    this->recorrido = 0;
+    this->velocidad = (uint16_t)v;
+    this->moviendo = (total != 0);
+    return resultado;
+}
+
+// Metodo para avanzar el movimiento lineal una vez por trama (llamar desde loop)
+void CinematicaInversa::actualizar() {
+    if (!this->moviendo || !this->tramaNueva) return;
+    this->tramaNueva = false;
+
+    // Punto sobre la recta: inicio + (destino − inicio) · recorrido / total
+    uint32_t s = (uint32_t)this->recorrido + this->velocidad;
+    S_PUNTO_IK p;
+    if (s >= this->recorridoTotal) {
+        p = this->destino;
+        s = this->recorridoTotal;
+    } else {
+        int32_t total = this->recorridoTotal;
+        p.x = this->inicio.x + ((int32_t)(this->destino.x - this->inicio.x) * (int32_t)s) / total;
+        p.y = this->inicio.y + ((int32_t)(this->destino.y - this->inicio.y) * (int32_t)s) / total;
+        p.z = this->inicio.z + ((int32_t)(this->destino.z - this->inicio.z) * (int32_t)s) / total;
+    }
+
+    uint16_t angulosQ8[MAX_ARTICULACIONES_IK];
+    E_RESULTADO_IK resultado = resolver(p, angulosQ8);
+    this->ultimoResultado = resultado;
+    if (resultado == E_RESULTADO_IK::FUERA_DE_ALCANCE || resultado == E_RESULTADO_IK::SIN_CONFIGURAR) {
+        // La recta sale del espacio de trabajo: el brazo se queda en el último punto válido
+        this->moviendo = false;
+        return;
+    }
+
+    this->actual = p;
+    this->recorrido = (uint16_t)s;
+    if (s >= this->recorridoTotal) this->moviendo = false;
+    aplicar(angulosQ8);
+}
+
+// Tarea de trama: marca la trama nueva de las cinemáticas del timer (desde la ISR TOVn)
+void CinematicaInversa::marcarTrama(E_TIMMER_ASCIOADO timmer) {
+    for (uint8_t i = 0; i < numCinematicas; i++) {
+        CinematicaInversa* c = cinematicas[i];
+        if (c->numArticulaciones != 0 && c->timmerMaestro == timmer) c->tramaNueva = true;
+    }
+}
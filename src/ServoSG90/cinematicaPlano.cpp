@@ -0,0 +1,42 @@
+#include "ServoSG90/cinematicaPlano.h"
+
+
+// Metodo para resolver hombro y codo (BAM16) del punto (r, z); false si no es alcanzable
+bool CinematicaPlano::inversa(uint16_t longitudBrazo, uint16_t longitudAntebrazo, bool codoArriba,
+                              int16_t r, int16_t z, uint16_t& hombro, uint16_t& codo) {
+    uint32_t l1 = longitudBrazo;
+    uint32_t l2 = longitudAntebrazo;
+
+    // Alcance: |L1 − L2| ≤ d ≤ L1 + L2 (comparado al cuadrado)
+    uint32_t d2 = (uint32_t)((int32_t)r * r) + (uint32_t)((int32_t)z * z);
+    uint32_t suma = l1 + l2;
+    uint32_t diferencia = (l1 > l2) ? l1 - l2 : l2 - l1;
+    if (d2 == 0 || d2 > suma * suma || d2 < diferencia * diferencia) return false;
+
+    // Ley del coseno: cos(codo) = N / D; N y D se reducen a 15 bits para que D² quepa en 32
+    int32_t  n = (int32_t)d2 - (int32_t)(l1 * l1) - (int32_t)(l2 * l2);
+    uint32_t d = 2 * l1 * l2;
+    while (d >= (1UL << 15)) { d >>= 1; n >>= 1; }
+    if (n > (int32_t)d)  n = d;
+    if (n < -(int32_t)d) n = -(int32_t)d;
+    uint16_t s = TrigFijo::raizCuadrada(d * d - (uint32_t)(n * n));
+
+    codo = TrigFijo::atan2(codoArriba ? -(int32_t)s : (int32_t)s, n);
+
+    // Hombro: dirección del punto menos el ángulo que aporta el antebrazo
+    int32_t k1 = ((int32_t)l1 << 15) + (int32_t)l2 * TrigFijo::coseno(codo);
+    int32_t k2 = (int32_t)l2 * TrigFijo::seno(codo);
+    hombro = TrigFijo::atan2(z, r) - TrigFijo::atan2(k2, k1);
+    return true;
+}
+
+// Metodo para calcular el punto (r, z) del extremo con hombro y codo (BAM16)
+void CinematicaPlano::directa(uint16_t longitudBrazo, uint16_t longitudAntebrazo, uint16_t hombro, uint16_t codo,
+                              int32_t& r, int32_t& z) {
+    // L1 y L2 ≤ 2^13, seno Q15 → cada producto cabe en 2^28
+    int32_t l1 = longitudBrazo;
+    int32_t l2 = longitudAntebrazo;
+    uint16_t extremo = hombro + codo;
+    r = (l1 * TrigFijo::coseno(hombro) + l2 * TrigFijo::coseno(extremo) + 16384L) >> 15;
+    z = (l1 * TrigFijo::seno(hombro)   + l2 * TrigFijo::seno(extremo)   + 16384L) >> 15;
+}
@@ -0,0 +1,199 @@
+#include "ServoSG90/coordinador.h"
+
+CoordinadorServos* CoordinadorServos::coordinadores[MAX_COORDINADORES];
+uint8_t            CoordinadorServos::numCoordinadores = 0;
+
+
+// Constructor: registra el coordinador en la lista de tareas de trama
+CoordinadorServos::CoordinadorServos() {
+    if (numCoordinadores >= MAX_COORDINADORES) return;
+    if (!TramaTimmer::agregarTarea(avanzarTrama)) return;
+
+    ATOMIC_BLOCK(ATOMIC_RESTORESTATE) {
+        coordinadores[numCoordinadores++] = this;
+    }
+    this->registrado = true;
+}
+
+// Metodo para añadir un eje inicializado (pasa a modo de actualizacion por trama)
+bool CoordinadorServos::agregar(ServoMotor& servo) {
+    if (!this->registrado) return false;
+    if (this->numEjes >= MAX_EJES_COORDINADOS) return false;
+    if (!servo.ServoInicializado) return false;
+    if (enMovimiento()) return false;
+
+    const S_CANAL_OC& canal = servo.timmerServo.canal;
+    uint8_t k = TramaTimmer::indiceCanal(canal);
+
+    S_EJE_COORDINADO& e = this->ejes[this->numEjes];
+    e.servo     = &servo;
+    e.trama     = &TramaTimmer::tramas[static_cast<uint8_t>(canal.timmer)];
+    e.indice    = k;
+    e.bitCanal  = (1 << k);
+    e.actual    = servo.timmerServo.registroOCRData;
+    e.inicio    = e.actual;
+    e.destino   = e.actual;
+
+    // La ISR del timer maestro no ve el eje hasta que está completo
+    ATOMIC_BLOCK(ATOMIC_RESTORESTATE) {
+        if (this->numEjes == 0) this->timmerMaestro = canal.timmer;
+        this->numEjes++;
+    }
+
+    // TOVn habilitada también en los timers que no son el maestro (confirman sus OCR)
+    servo.configurarModoActualizacion(E_MODO_ACTUALIZACION::TRAMA);
+    return true;
+}
+
+// Metodo para mover todos los ejes a ticks (uno por eje, en orden de alta) en duracionMs
+bool CoordinadorServos::moverTicks(const uint16_t* ticks, uint8_t n, uint16_t duracionMs,
+                                   E_SUAVIZADO curva) {
+    if (n != this->numEjes || n == 0) return false;
+
+    uint16_t limitados[MAX_EJES_COORDINADOS];
+    for (uint8_t i = 0; i < n; i++) {
+        const ServoMotor* s = this->ejes[i].servo;
+        uint16_t t = ticks[i];
+        if (t < s->ticksMin) t = s->ticksMin;
+        if (t > s->ticksMax) t = s->ticksMax;
+        limitados[i] = t;
+        this->ejes[i].servo->reconectarSiPendiente();
+    }
+
+    uint16_t tramas = Timmer::msATramas(duracionMs);
+    planificar(limitados, n, tramas ? tramas : 1, curva);
+    return true;
+}
+
+// Metodo para mover todos los ejes a angulos (uno por eje, en orden de alta) en duracionMs
+bool CoordinadorServos::moverAngulos(const uint8_t* angulos, uint8_t n, uint16_t duracionMs,
+                                     E_SUAVIZADO curva) {
+    if (n != this->numEjes || n == 0) return false;
+
+    uint16_t ticks[MAX_EJES_COORDINADOS];
+    for (uint8_t i = 0; i < n; i++) {
+        ServoMotor* s = this->ejes[i].servo;
+        ticks[i] = s->ticksDeAngulo(angulos[i]);
+        s->angle = (angulos[i] > ANGULO_MAX_SERVO) ? ANGULO_MAX_SERVO : angulos[i];
+    }
+    return moverTicks(ticks, n, duracionMs, curva);
+}
+
+// Metodo para mover a angulos con el eje de mayor recorrido a velocidadGradosS (°/s, media)
+bool CoordinadorServos::moverAngulosVelocidad(const uint8_t* angulos, uint8_t n, uint16_t velocidadGradosS,
+                                              E_SUAVIZADO curva) {
+    if (n != this->numEjes || n == 0 || velocidadGradosS == 0) return false;
+
+    // Duración del eje más lento: recorrido en grados (según la pendiente de cada eje) / velocidad
+    uint32_t duracionMs = 0;
+    for (uint8_t i = 0; i < n; i++) {
+        const S_EJE_COORDINADO& e = this->ejes[i];
+        uint16_t destino = e.servo->ticksDeAngulo(angulos[i]);
+        uint16_t actual;
+        ATOMIC_BLOCK(ATOMIC_RESTORESTATE) {
+            actual = e.servo->timmerServo.registroOCRData;
+        }
+        uint16_t recorrido = (destino > actual) ? destino - actual : actual - destino;
+        uint16_t ticksPorGradoQ8 = e.servo->ticksPorGradoQ8;
+        if (ticksPorGradoQ8 == 0) continue;
+
+        // ms = recorrido · 256 · 1000 / (ticksPorGradoQ8 · v)
+        uint32_t ms = ((uint32_t)recorrido * 256000UL / ticksPorGradoQ8 + velocidadGradosS - 1) / velocidadGradosS;
+        if (ms > duracionMs) duracionMs = ms;
+    }
+    if (duracionMs > 0xFFFF) duracionMs = 0xFFFF;
+    return moverAngulos(angulos, n, (uint16_t)duracionMs, curva);
+}
+
+// Metodo para saber si queda alguna trama del movimiento
+bool CoordinadorServos::enMovimiento() {
+    uint16_t restantes;
+    ATOMIC_BLOCK(ATOMIC_RESTORESTATE) {
+        restantes = this->tramasRestantes;
+    }
+    return restantes != 0;
+}
+
+// Metodo para detener el movimiento en la consigna actual
+void CoordinadorServos::detener() {
+    ATOMIC_BLOCK(ATOMIC_RESTORESTATE) {
+        this->tramasRestantes = 0;
+        for (uint8_t i = 0; i < this->numEjes; i++) {
+            S_EJE_COORDINADO& e = this->ejes[i];
+            e.inicio  = e.actual;
+            e.destino = e.actual;
+        }
+    }
+}
+
+// Metodo para planificar el movimiento en un numero de tramas dado
+void CoordinadorServos::planificar(const uint16_t* ticks, uint8_t n, uint16_t tramas, E_SUAVIZADO curva) {
+    // Los ejes se detienen y el nuevo movimiento parte de la consigna actual de cada servo: la del
+    // coordinador o la de otro escritor entre dos movimientos (escritura directa, planificador,
+    // grupo, rampa de arranque ya anulada por reconectarSiPendiente)
+    detener();
+    uint32_t incremento = 0x10000UL / tramas;
+    uint16_t resto      = 0x10000UL % tramas;
+
+    ATOMIC_BLOCK(ATOMIC_RESTORESTATE) {
+        for (uint8_t i = 0; i < n; i++) {
+            S_EJE_COORDINADO& e = this->ejes[i];
+            e.actual  = e.servo->timmerServo.registroOCRData;
+            e.inicio  = e.actual;
+            e.destino = ticks[i];
+        }
+        this->progreso        = 0;
+        this->incremento      = incremento;
+        this->resto           = resto;
+        this->acumuladoResto  = 0;
+        this->tramasTotales   = tramas;
+        this->curva           = curva;
+        this->tramasRestantes = tramas;
+    }
+}
+
+// Avanza una trama y deja preparados los OCR de todos los ejes (interrupciones deshabilitadas)
+void CoordinadorServos::avanzar() {
+    uint16_t restantes = this->tramasRestantes;
+    if (restantes == 0) return;
+    restantes--;
+
+    // Progreso común: todos los ejes en la misma fracción de su recorrido. El resto de 2^16 / tramas
+    // se acumula (sin división en la ISR): la última trama no salta al destino
+    this->progreso += this->incremento;
+    this->acumuladoResto += this->resto;
+    if (this->acumuladoResto >= this->tramasTotales) {
+        this->acumuladoResto -= this->tramasTotales;
+        this->progreso++;
+    }
+    uint16_t s = restantes ? Suavizado::aplicar(this->curva, (uint16_t)this->progreso) : 0;
+
+    for (uint8_t i = 0; i < this->numEjes; i++) {
+        S_EJE_COORDINADO& e = this->ejes[i];
+        if (restantes == 0) {
+            // Última trama: todos los ejes exactamente en su destino
+            e.actual = e.destino;
+        } else {
+            int32_t delta = (int32_t)e.destino - e.inicio;
+            e.actual = e.inicio + (int16_t)((delta * s) >> 16);
+        }
+
+        // Consigna del servo al día en cada trama: detener(), guardarPosiciones() y los demás
+        // escritores parten de ella
+        e.servo->timmerServo.registroOCRData = e.actual;
+        e.servo->ticks = e.actual;
+        e.trama->ticks[e.indice] = e.actual;
+        e.trama->conFraccion &= ~e.bitCanal;
+        e.trama->pendientes |= e.bitCanal;
+    }
+    this->tramasRestantes = restantes;
+}
+
+// Tarea de trama: avanza los coordinadores del timer maestro (desde la ISR TOVn)
+void CoordinadorServos::avanzarTrama(E_TIMMER_ASCIOADO timmer) {
+    for (uint8_t i = 0; i < numCoordinadores; i++) {
+        CoordinadorServos* c = coordinadores[i];
+        if (c->numEjes == 0 || c->timmerMaestro != timmer) continue;
+        c->avanzar();
+    }
+}
@@ -0,0 +1,113 @@
+#include "ServoSG90/gestorTimmers.h"
+
+// Timer0 pertenece al core desde el arranque (millis/delay)
+S_RECURSO_TIMMER GestorTimmers::recursos[NUM_TIMMERS] = {
+    { E_MODO_TIMMER::CORE_MILLIS, 0xFF, 0, { nullptr, nullptr, nullptr } },   // Timer0
+    { E_MODO_TIMMER::LIBRE,       0,    0, { nullptr, nullptr, nullptr } },   // Timer1
+    { E_MODO_TIMMER::LIBRE,       0,    0, { nullptr, nullptr, nullptr } },   // Timer2
+    { E_MODO_TIMMER::LIBRE,       0,    0, { nullptr, nullptr, nullptr } },   // Timer3
+    { E_MODO_TIMMER::LIBRE,       0,    0, { nullptr, nullptr, nullptr } },   // Timer4
+    { E_MODO_TIMMER::LIBRE,       0,    0, { nullptr, nullptr, nullptr } },   // Timer5
+};
+
+static const char* nombreModo(E_MODO_TIMMER modo) {
+    switch (modo) {
+        case E_MODO_TIMMER::CORE_MILLIS:  return "Core millis";
+        case E_MODO_TIMMER::FAST_PWM_ICR: return "Fast PWM ICR";
+        case E_MODO_TIMMER::CTC_ICR:      return "CTC ICR";
+        case E_MODO_TIMMER::NORMAL_8BITS: return "Normal 8 bits";
+        case E_MODO_TIMMER::PWM_RAPIDO:   return "PWM rapido";
+        case E_MODO_TIMMER::PWM_FASE:     return "PWM fase";
+        default:                          return "Libre";
+    }
+}
+
+static void printFijo(const char* text, uint8_t width) {
+    uint8_t len = text ? strlen(text) : 0;
+    for (uint8_t i = 0; i < width; i++) {
+        Serial.print(i < len ? text[i] : ' ');
+    }
+}
+
+
+// Metodo para reservar un canal de un timer en un modo, TOP y prescaler determinados
+E_RESERVA_TIMMER GestorTimmers::reservar(E_TIMMER_ASCIOADO timmer, E_MODO_TIMMER modo, uint16_t top,
+                                         uint8_t canal, const char* dueno, uint8_t bitsCS) {
+    uint8_t t = static_cast<uint8_t>(timmer);
+    if (t >= NUM_TIMMERS || canal >= NUM_CANALES_TIMMER || modo == E_MODO_TIMMER::LIBRE) {
+        return E_RESERVA_TIMMER::CONFLICTO;
+    }
+    S_RECURSO_TIMMER& r = recursos[t];
+
+    // Timer0 solo admite usuarios que conservan la configuración del core
+    if (timmer == E_TIMMER_ASCIOADO::TIMMER0 && modo != E_MODO_TIMMER::CORE_MILLIS) {
+        return E_RESERVA_TIMMER::CONFLICTO;
+    }
+    if (r.duenos[canal] != nullptr) return E_RESERVA_TIMMER::CONFLICTO;
+
+    E_RESERVA_TIMMER resultado;
+    if (r.modo == E_MODO_TIMMER::LIBRE) {
+        r.modo = modo;
+        r.top  = top;
+        r.bitsCS = bitsCS;
+        resultado = E_RESERVA_TIMMER::CONFIGURAR;
+    } else if (r.modo == modo && r.top == top && r.bitsCS == bitsCS) {
+        resultado = E_RESERVA_TIMMER::COMPARTIDO;
+    } else {
+        return E_RESERVA_TIMMER::CONFLICTO;
+    }
+
+    r.duenos[canal] = dueno ? dueno : "?";
+    return resultado;
+}
+
+// Metodo para liberar un canal (el timer queda libre cuando no le quedan canales)
+void GestorTimmers::liberar(E_TIMMER_ASCIOADO timmer, uint8_t canal) {
+    uint8_t t = static_cast<uint8_t>(timmer);
+    if (t >= NUM_TIMMERS || canal >= NUM_CANALES_TIMMER) return;
+    S_RECURSO_TIMMER& r = recursos[t];
+    r.duenos[canal] = nullptr;
+
+    if (r.modo == E_MODO_TIMMER::CORE_MILLIS) return;
+    for (uint8_t k = 0; k < NUM_CANALES_TIMMER; k++) {
+        if (r.duenos[k] != nullptr) return;
+    }
+    r.modo = E_MODO_TIMMER::LIBRE;
+    r.top  = 0;
+    r.bitsCS = 0;
+}
+
+// Metodo para consultar el modo registrado de un timer
+E_MODO_TIMMER GestorTimmers::modo(E_TIMMER_ASCIOADO timmer) {
+    uint8_t t = static_cast<uint8_t>(timmer);
+    return (t < NUM_TIMMERS) ? recursos[t].modo : E_MODO_TIMMER::LIBRE;
+}
+
+// Metodo para imprimir la tabla de dueños de timers y canales
+void GestorTimmers::imprimirResumen() {
+    Serial.println(F("+--------+----------------+-------+----------------+----------------+----------------+"));
+    Serial.println(F("| Timer  | Modo           | TOP   | Canal A        | Canal B        | Canal C        |"));
+    Serial.println(F("+--------+----------------+-------+----------------+----------------+----------------+"));
+
+    for (uint8_t t = 0; t < NUM_TIMMERS; t++) {
+        const S_RECURSO_TIMMER& r = recursos[t];
+        char texto[8];
+
+        Serial.print(F("| Timer"));
+        Serial.print(t);
+        Serial.print(F(" | "));
+        printFijo(nombreModo(r.modo), 15);
+
+        Serial.print(F("| "));
+        utoa(r.top, texto, 10);
+        printFijo(r.modo == E_MODO_TIMMER::LIBRE ? "-" : texto, 6);
+
+        for (uint8_t k = 0; k < NUM_CANALES_TIMMER; k++) {
+            Serial.print(F("| "));
+            printFijo(r.duenos[k] ? r.duenos[k] : "-", 15);
+        }
+        Serial.println(F("|"));
+    }
+    Serial.println(F("+--------+----------------+-------+----------------+----------------+----------------+"));
+    Serial.println();
+}
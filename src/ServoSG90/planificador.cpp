@@ -0,0 +1,516 @@
+#include "ServoSG90/planificador.h"
+#include "ServoSG90/trigFijo.h"
+
+PlanificadorServo* PlanificadorServo::planificadores[MAX_PLANIFICADORES];
+uint8_t            PlanificadorServo::numPlanificadores = 0;
+
+// Signo del jerk en cada segmento de la curva S
+static const int8_t SIGNO_JERK_CURVA_S[SEGMENTOS_CURVA_S] = { 1, 0, -1, 0, -1, 0, 1 };
+
+
+// Constructor: registra el planificador en la trama del timer del servo
+PlanificadorServo::PlanificadorServo(ServoMotor& servo)
+    : servo(&servo), canal(&servo.timmerServo.canal)
+{
+    if (!servo.ServoInicializado) return;
+    if (numPlanificadores >= MAX_PLANIFICADORES) return;
+    if (!TramaTimmer::agregarTarea(avanzarTrama)) return;
+
+    // Arranca desde la consigna actual del servo (3000 ticks tras initTimmer)
+    uint16_t actual = servo.timmerServo.registroOCRData;
+    this->objetivo = actual;
+    this->posicion = (int32_t)actual << 8;
+
+    ATOMIC_BLOCK(ATOMIC_RESTORESTATE) {
+        planificadores[numPlanificadores++] = this;
+    }
+    this->registrado = true;
+    TramaTimmer::habilitar(*this->canal);
+}
+
+// Metodo para fijar velocidad (°/s) y aceleración (°/s²) máximas
+void PlanificadorServo::configurarLimites(uint16_t velocidadGradosS, uint16_t aceleracionGradosS2) {
+    // Ticks por grado en Q8 según la tabla o el perfil de calibración del servo
+    uint32_t ticksPorGradoQ8 = servo->ticksPorGradoQ8;
+
+    uint32_t v = velocidadATramas(velocidadGradosS);
+    uint32_t hz = Timmer::hzTramaServo;
+    uint32_t a = (uint32_t)aceleracionGradosS2 * ticksPorGradoQ8 / (hz * hz);
+    if (a > 0xFFFF) a = 0xFFFF;
+    if (a == 0) a = 1;
+
+    ATOMIC_BLOCK(ATOMIC_RESTORESTATE) {
+        this->velocidadMax   = v;
+        this->aceleracionMax = a;
+    }
+}
+
+// Metodo para fijar el jerk máximo (°/s³) de la curva S
+void PlanificadorServo::configurarJerk(uint16_t jerkGradosS3) {
+    uint32_t ticksPorGradoQ8 = servo->ticksPorGradoQ8;
+
+    // Q16 ticks/trama³ = °/s³ · ticksPorGradoQ8 · 256 / hz³ (64 bits: solo al configurar)
+    uint32_t hz = Timmer::hzTramaServo;
+    uint64_t j = ((uint64_t)jerkGradosS3 * ticksPorGradoQ8 << 8) / (hz * hz * hz);
+    if (j > 0xFFFFFFFFUL) j = 0xFFFFFFFFUL;
+    if (j == 0) j = 1;
+
+    ATOMIC_BLOCK(ATOMIC_RESTORESTATE) {
+        this->jerkMax = j;
+    }
+}
+
+// Metodo para elegir el perfil de movimiento (solo con el servo parado)
+bool PlanificadorServo::configurarPerfil(E_PERFIL_MOVIMIENTO perfil) {
+    if (enMovimiento()) return false;
+    ATOMIC_BLOCK(ATOMIC_RESTORESTATE) {
+        this->perfil = perfil;
+    }
+    return true;
+}
+
+// Metodo para publicar un destino en grados (0-180)
+bool PlanificadorServo::moverA(uint8_t angulo) {
+    if (!servo->ServoInicializado) return false;
+    servo->angle = (angulo > ANGULO_MAX_SERVO) ? ANGULO_MAX_SERVO : angulo;
+    return moverATicks(servo->ticksDeAngulo(angulo));
+}
+
+// Metodo para publicar un destino en ticks de 0.5 µs (limitado al rango del servo)
+bool PlanificadorServo::moverATicks(uint16_t ticks) {
+    if (!servo->ServoInicializado || !this->registrado) return false;
+    if (ticks < servo->ticksMin) ticks = servo->ticksMin;
+    if (ticks > servo->ticksMax) ticks = servo->ticksMax;
+    servo->reconectarSiPendiente();
+    sincronizarConsigna();
+
+    if (this->perfil == E_PERFIL_MOVIMIENTO::CURVA_S) return planificarCurvaS(ticks);
+
+    // Sustituye la cola: el nuevo destino es el único
+    ATOMIC_BLOCK(ATOMIC_RESTORESTATE) {
+        this->numSegmentos = 0;
+        this->objetivo = ticks;
+    }
+    return true;
+}
+
+// Metodo para encolar un destino en grados (0-180) a velocidadGradosS (0 = límite general)
+bool PlanificadorServo::encolar(uint8_t angulo, uint16_t velocidadGradosS) {
+    if (!servo->ServoInicializado) return false;
+    return encolarTicks(servo->ticksDeAngulo(angulo), velocidadGradosS);
+}
+
+// Metodo para encolar un destino en ticks de 0.5 µs (false si la cola está llena o el perfil es CURVA_S)
+bool PlanificadorServo::encolarTicks(uint16_t ticks, uint16_t velocidadGradosS) {
+    if (!servo->ServoInicializado || !this->registrado) return false;
+    if (this->perfil != E_PERFIL_MOVIMIENTO::TRAPECIO) return false;
+    if (ticks < servo->ticksMin) ticks = servo->ticksMin;
+    if (ticks > servo->ticksMax) ticks = servo->ticksMax;
+    servo->reconectarSiPendiente();
+    sincronizarConsigna();
+
+    uint32_t v = velocidadGradosS ? velocidadATramas(velocidadGradosS) : this->velocidadMax;
+    if (v > this->velocidadMax) v = this->velocidadMax;
+
+    bool encolado = false;
+    ATOMIC_BLOCK(ATOMIC_RESTORESTATE) {
+        // Con la cola vacía, un destino de moverA() aún sin alcanzar pasa a ser el primer segmento
+        bool conObjetivo = (this->numSegmentos == 0) &&
+                           (this->velocidad != 0 || this->posicion != ((int32_t)this->objetivo << 8));
+        uint8_t necesarios = conObjetivo ? 2 : 1;
+
+        if (CAPACIDAD_COLA_MOVIMIENTOS - this->numSegmentos >= necesarios) {
+            uint8_t k = (this->cabeza + this->numSegmentos) & MASCARA_COLA_MOVIMIENTOS;
+            if (conObjetivo) {
+                this->cola[k] = { this->objetivo, this->velocidadMax, 0 };
+                k = (k + 1) & MASCARA_COLA_MOVIMIENTOS;
+            }
+            this->cola[k] = { ticks, (uint16_t)v, 0 };
+            this->numSegmentos += necesarios;
+            encolado = true;
+        }
+    }
+    if (!encolado) return false;
+
+    anticipar();
+    return true;
+}
+
+// Metodo para leer los segmentos libres de la cola
+uint8_t PlanificadorServo::espacioCola() {
+    uint8_t n;
+    ATOMIC_BLOCK(ATOMIC_RESTORESTATE) {
+        n = this->numSegmentos;
+    }
+    return CAPACIDAD_COLA_MOVIMIENTOS - n;
+}
+
+// Metodo para vaciar la cola (el servo frena en el destino del segmento en curso)
+void PlanificadorServo::vaciarCola() {
+    ATOMIC_BLOCK(ATOMIC_RESTORESTATE) {
+        if (this->numSegmentos > 1) {
+            this->numSegmentos = 1;
+            this->cola[this->cabeza].velocidadSalida = 0;
+        }
+    }
+}
+
+// Metodo para saber si el servo sigue en movimiento
+bool PlanificadorServo::enMovimiento() {
+    bool moviendo;
+    ATOMIC_BLOCK(ATOMIC_RESTORESTATE) {
+        moviendo = this->curvaActiva || (this->numSegmentos != 0) || (this->velocidad != 0) || (this->posicion != ((int32_t)this->objetivo << 8));
+    }
+    return moviendo;
+}
+
+// Metodo para leer la consigna actual en ticks
+uint16_t PlanificadorServo::posicionTicks() {
+    int32_t p;
+    ATOMIC_BLOCK(ATOMIC_RESTORESTATE) {
+        p = this->posicion;
+    }
+    return (uint16_t)((p + 128) >> 8);
+}
+
+// Distancia (Q8) que se recorre frenando desde v hasta 0
+uint32_t PlanificadorServo::distanciaFrenado(uint16_t v, uint16_t a) {
+    uint16_t q = v / a;
+    if (q == 0) return 0;
+    // q·v − a·q·(q+1)/2, sin desbordar 32 bits (a·q ≤ v ≤ 0xFFFF)
+    return (uint32_t)q * v - (((uint32_t)(a * q) * (q + 1)) >> 1);
+}
+
+// Convierte °/s a Q8 ticks/trama con la pendiente del servo
+uint32_t PlanificadorServo::velocidadATramas(uint16_t velocidadGradosS) {
+    uint32_t ticksPorGradoQ8 = servo->ticksPorGradoQ8;
+    uint32_t v = (uint32_t)velocidadGradosS * ticksPorGradoQ8 / Timmer::hzTramaServo;
+    if (v > 0xFFFF) v = 0xFFFF;
+    if (v == 0) v = 1;
+    return v;
+}
+
+// Recalcula de atrás hacia delante la velocidad de salida de los segmentos encolados
+void PlanificadorServo::anticipar() {
+    S_SEGMENTO_MOVIMIENTO segmentos[CAPACIDAD_COLA_MOVIMIENTOS];
+    uint16_t salidas[CAPACIDAD_COLA_MOVIMIENTOS];
+    uint8_t n, primero;
+    int32_t posicionActual;
+
+    // Copia de la cola: las raíces se calculan con las interrupciones habilitadas
+    ATOMIC_BLOCK(ATOMIC_RESTORESTATE) {
+        n = this->numSegmentos;
+        primero = this->cabeza;
+        posicionActual = this->posicion;
+        for (uint8_t i = 0; i < n; i++) {
+            segmentos[i] = this->cola[(primero + i) & MASCARA_COLA_MOVIMIENTOS];
+        }
+    }
+    if (n < 2) return;
+
+    uint16_t a = this->aceleracionMax;
+    int8_t cambiados = n - 1;                     // Primer índice con salida recalculada
+    salidas[n - 1] = 0;
+    for (int8_t i = n - 2; i >= 0; i--) {
+        uint16_t desde = (i == 0) ? (uint16_t)((posicionActual + 128) >> 8) : segmentos[i - 1].destino;
+        int32_t actual    = (int32_t)segmentos[i].destino - desde;
+        int32_t siguiente = (int32_t)segmentos[i + 1].destino - segmentos[i].destino;
+
+        // Solo se cruza sin parar si el siguiente segmento sigue en el mismo sentido
+        uint16_t v = 0;
+        if (actual != 0 && siguiente != 0 && ((actual > 0) == (siguiente > 0))) {
+            // Mayor v que frena hasta la salida siguiente aunque cruce una trama entera tarde:
+            // v² + a·v ≤ vs² − a·vs + 2·a·L   →   v = (√(a² + 4·K) − a) / 2
+            uint32_t longitud = (uint32_t)(siguiente > 0 ? siguiente : -siguiente) << 8;
+            uint16_t vs = salidas[i + 1];
+            int64_t k = (int64_t)vs * vs - (int64_t)a * vs + 2LL * a * longitud;
+            uint64_t r = (uint64_t)a * a + 4ULL * (uint64_t)(k > 0 ? k : 0);
+            uint8_t escala = 0;
+            while (r > 0xFFFFFFFFULL) { r >>= 2; escala++; }     // Raíz por defecto: nunca sobrestima
+            uint32_t raiz = (uint32_t)TrigFijo::raizCuadrada((uint32_t)r) << escala;
+            uint32_t vMaxima = (raiz - a) / 2;
+            v = (vMaxima > 0xFFFF) ? 0xFFFF : vMaxima;
+            if (v > segmentos[i].velocidadMax)     v = segmentos[i].velocidadMax;
+            if (v > segmentos[i + 1].velocidadMax) v = segmentos[i + 1].velocidadMax;
+        }
+
+        // Sin cambios aquí: los anteriores tampoco cambian
+        if (v == segmentos[i].velocidadSalida) break;
+        salidas[i] = v;
+        cambiados = i;
+    }
+
+    // Los segmentos que la ISR ya ha terminado no se tocan
+    ATOMIC_BLOCK(ATOMIC_RESTORESTATE) {
+        uint8_t terminados = n - this->numSegmentos;
+        for (uint8_t i = (cambiados > terminados) ? cambiados : terminados; i < n - 1; i++) {
+            this->cola[(primero + i) & MASCARA_COLA_MOVIMIENTOS].velocidadSalida = salidas[i];
+        }
+    }
+}
+
+// Planifica una curva S hasta destino (en loop) y la arranca o la deja pendiente
+bool PlanificadorServo::planificarCurvaS(uint16_t destino) {
+    bool activa;
+    uint8_t libre;
+    uint16_t desde;
+
+    // Se anula el pendiente anterior: la ISR no cambia de plan mientras se escribe el libre
+    ATOMIC_BLOCK(ATOMIC_RESTORESTATE) {
+        this->curvaPendiente = false;
+        activa = this->curvaActiva;
+        libre  = this->planActivo ^ 1;
+        desde  = activa ? this->planes[this->planActivo].destino
+                        : (uint16_t)((this->posicion + 128) >> 8);
+    }
+
+    if (desde == destino) {
+        ATOMIC_BLOCK(ATOMIC_RESTORESTATE) {
+            this->objetivo = destino;
+        }
+        return true;
+    }
+
+    if (!calcularCurvaS(this->planes[libre], desde, destino)) return false;
+
+    ATOMIC_BLOCK(ATOMIC_RESTORESTATE) {
+        this->objetivo = destino;
+        if (this->curvaActiva) {
+            // Arranca al terminar la curva en curso (la ISR cambia de plan)
+            this->curvaPendiente = true;
+        } else {
+            this->planActivo         = libre;
+            this->trama              = 0;
+            this->segmento           = 0;
+            this->acelUnitaria       = 0;
+            this->velUnitaria        = 0;
+            this->recorridoUnitario  = 0;
+            this->curvaActiva        = true;
+        }
+    }
+    return true;
+}
+
+// Calcula límites de segmento y escala de una curva S entre inicio y destino
+bool PlanificadorServo::calcularCurvaS(S_PLAN_CURVA_S& plan, uint16_t inicio, uint16_t destino) {
+    uint16_t d = (destino > inicio) ? destino - inicio : inicio - destino;
+
+    // Límites en Q16 por trama; un jerk mayor que a o v no limita nada
+    uint32_t v = (uint32_t)this->velocidadMax << 8;
+    uint32_t a = (uint32_t)this->aceleracionMax << 8;
+    uint32_t j = this->jerkMax;
+    if (j > a) j = a;
+    if (j > v) j = v;
+
+    // Tj desde a/J; si no se alcanza a antes de vMax, perfil sin tramo de aceleración constante
+    uint32_t vu = v / j;                          // Vu máxima (unidades de jerk)
+    uint32_t tj = a / j;
+    uint32_t ta = 0;
+    if (tj > MAX_TJ_CURVA_S) tj = MAX_TJ_CURVA_S;
+    if (tj * tj > vu) {
+        tj = TrigFijo::raizCuadrada(vu);
+        if (tj == 0) tj = 1;
+    } else {
+        ta = vu / tj - tj;
+        if (ta > MAX_TA_CURVA_S) ta = MAX_TA_CURVA_S;
+    }
+
+    // Recorridos cortos: se recorta Ta y después Tj hasta que acelerar y frenar quepa en d
+    uint32_t du = ((uint32_t)d << 16) / j;        // Recorrido disponible con jerk unitario
+    while (ta > 0 && tj * (tj + ta) * (2 * tj + ta) > du) ta--;
+    while (tj > 1 && tj * tj * (2 * tj) > du) tj--;
+
+    uint32_t velocidadU = tj * (tj + ta);
+    uint32_t tramasRampa = 2 * tj + ta;
+    uint32_t tv = 0;
+    if (velocidadU * tramasRampa < du) {
+        tv = (du - velocidadU * tramasRampa + velocidadU - 1) / velocidadU;
+    }
+
+    // Recortar el crucero superaría la velocidad y el jerk pedidos: el movimiento no se hace
+    if (2 * tramasRampa + tv > MAX_TRAMAS_CURVA_S) return false;
+
+    // Su ≤ du + Vu < 2^29. r deja Su >> r en 16 bits; s, la mayor con d·256·2^s < 2^31:
+    // (p >> r)·K ≤ d·256·2^s y (p mod 2^r)·K < 2^(r+17), la suma de la ISR cabe en 32 bits
+    uint32_t su = velocidadU * (tramasRampa + tv);
+    uint8_t  r = 0;
+    while ((su >> r) > 0xFFFF) r++;
+    uint8_t  s = 0;
+    while (((uint32_t)d << (9 + s)) < 0x80000000UL) s++;
+    uint64_t k = ((uint64_t)d << (8 + s + r)) / su;
+
+    plan.limites[0] = tj;
+    plan.limites[1] = plan.limites[0] + ta;
+    plan.limites[2] = plan.limites[1] + tj;
+    plan.limites[3] = plan.limites[2] + tv;
+    plan.limites[4] = plan.limites[3] + tj;
+    plan.limites[5] = plan.limites[4] + ta;
+    plan.limites[6] = plan.limites[5] + tj;
+    plan.escala         = (uint32_t)k;
+    plan.desplazamiento = s;
+    plan.reduccion      = r;
+    plan.inicio         = inicio;
+    plan.destino        = destino;
+    return true;
+}
+
+// Avanza una trama de la curva S y devuelve los ticks de la consigna (0 si no hay curva)
+uint16_t PlanificadorServo::avanzarCurvaS() {
+    if (!this->curvaActiva) return 0;
+    const S_PLAN_CURVA_S& plan = this->planes[this->planActivo];
+
+    // Integración con jerk unitario: tiempo constante por trama
+    this->trama++;
+    while (this->segmento < SEGMENTOS_CURVA_S - 1 && this->trama > plan.limites[this->segmento]) {
+        this->segmento++;
+    }
+    this->acelUnitaria      += SIGNO_JERK_CURVA_S[this->segmento];
+    this->velUnitaria       += this->acelUnitaria;
+    this->recorridoUnitario += this->velUnitaria;
+
+    if (this->trama >= plan.limites[SEGMENTOS_CURVA_S - 1]) {
+        // Última trama: exactamente en el destino; arranca el plan pendiente si lo hay
+        uint16_t destino = plan.destino;
+        this->posicion  = (int32_t)destino << 8;
+        this->velocidad = 0;
+        if (this->curvaPendiente) {
+            this->planActivo        ^= 1;
+            this->trama              = 0;
+            this->segmento           = 0;
+            this->acelUnitaria       = 0;
+            this->velUnitaria        = 0;
+            this->recorridoUnitario  = 0;
+            this->curvaPendiente     = false;
+        } else {
+            this->curvaActiva = false;
+        }
+        return destino;
+    }
+
+    int32_t anterior = this->posicion;
+    // Dos productos de 32 bits: parte alta y resto del recorrido unitario reducido por 2^r
+    uint32_t p = this->recorridoUnitario;
+    uint32_t resto = p & ((1UL << plan.reduccion) - 1);
+    uint32_t escalado = (p >> plan.reduccion) * plan.escala + ((resto * plan.escala) >> plan.reduccion);
+    int32_t recorrido = (int32_t)(escalado >> plan.desplazamiento);
+    int32_t inicio = (int32_t)plan.inicio << 8;
+    this->posicion  = (plan.destino > plan.inicio) ? inicio + recorrido : inicio - recorrido;
+    this->velocidad = this->posicion - anterior;
+    return (uint16_t)((this->posicion + 128) >> 8);
+}
+
+// Avanza una trama y devuelve los ticks de la nueva consigna (0 si el servo está parado en destino)
+uint16_t PlanificadorServo::avanzar() {
+    if (this->perfil == E_PERFIL_MOVIMIENTO::CURVA_S) return avanzarCurvaS();
+
+    // Segmento en curso de la cola (si la hay): destino, límite propio y velocidad de salida
+    uint16_t vMax = this->velocidadMax;
+    uint16_t vSalida = 0;
+    if (this->numSegmentos) {
+        const S_SEGMENTO_MOVIMIENTO& segmento = this->cola[this->cabeza];
+        this->objetivo = segmento.destino;
+        if (segmento.velocidadMax < vMax) vMax = segmento.velocidadMax;
+        vSalida = segmento.velocidadSalida;
+    }
+
+    int32_t destino = (int32_t)this->objetivo << 8;
+    int32_t d = destino - this->posicion;
+    int32_t v = this->velocidad;
+
+    if (d == 0 && v == 0) {
+        if (this->numSegmentos) siguienteSegmento();
+        return 0;
+    }
+
+    // Magnitudes en la dirección del destino
+    bool positivo = (d >= 0);
+    uint32_t dist = positivo ? d : -d;
+    int32_t vDir = positivo ? v : -v;
+    uint16_t a = this->aceleracionMax;
+
+    int32_t vNueva;
+    if (vDir < 0) {
+        // Alejándose del destino (cambio de objetivo): frenar primero
+        vNueva = vDir + a;
+        if (vNueva > 0) vNueva = 0;
+    } else {
+        // Mayor velocidad de { v + a, v, v - a } que aún permite frenar hasta vSalida en el destino
+        // Si vMax se ha reducido a mitad de movimiento, se baja hacia ella sin superar a
+        uint16_t vActual = (uint16_t)vDir;
+        uint16_t candidatos[3];
+        if (vActual > vMax) {
+            candidatos[0] = (vActual - vMax > a) ? vActual - a : vMax;
+            candidatos[1] = candidatos[0];
+        } else {
+            candidatos[0] = ((uint32_t)vActual + a > vMax) ? vMax : vActual + a;
+            candidatos[1] = vActual;
+        }
+        candidatos[2] = (vActual > a) ? vActual - a : 0;
+
+        uint32_t margen = distanciaFrenado(vSalida, a);
+        vNueva = candidatos[2];
+        for (uint8_t i = 0; i < 2; i++) {
+            uint16_t c = candidatos[i];
+            if (c <= dist ? (dist - c + margen >= distanciaFrenado(c, a)) : (c <= vSalida)) { vNueva = c; break; }
+        }
+        if (vNueva == 0) vNueva = (a < dist) ? a : dist;   // Arranque o último tramo
+    }
+
+    if (vNueva >= 0 && (uint32_t)vNueva >= dist) {
+        if (vSalida != 0 && this->numSegmentos > 1) {
+            // Cruce sin parar: la posición y la velocidad siguen en el siguiente segmento
+            v = positivo ? vNueva : -vNueva;
+            this->velocidad = v;
+            this->posicion += v;
+            siguienteSegmento();
+            return (uint16_t)((this->posicion + 128) >> 8);
+        }
+
+        // Llegada: fijar en el destino
+        this->posicion  = destino;
+        this->velocidad = 0;
+        if (this->numSegmentos) siguienteSegmento();
+        return this->objetivo;
+    }
+
+    v = positivo ? vNueva : -vNueva;
+    this->velocidad = v;
+    this->posicion += v;
+    return (uint16_t)((this->posicion + 128) >> 8);
+}
+
+// Parado: parte de la consigna actual del servo si otro escritor la cambió (rampa de arranque, escritura directa)
+void PlanificadorServo::sincronizarConsigna() {
+    ATOMIC_BLOCK(ATOMIC_RESTORESTATE) {
+        uint16_t actual = servo->timmerServo.registroOCRData;
+        bool parado = !this->curvaActiva && this->numSegmentos == 0 && this->velocidad == 0 &&
+                      this->posicion == ((int32_t)this->objetivo << 8);
+        if (parado && actual != this->objetivo) {
+            this->objetivo = actual;
+            this->posicion = (int32_t)actual << 8;
+        }
+    }
+}
+
+// Pasa al siguiente segmento de la cola (desde la ISR)
+void PlanificadorServo::siguienteSegmento() {
+    this->cabeza = (this->cabeza + 1) & MASCARA_COLA_MOVIMIENTOS;
+    this->numSegmentos--;
+}
+
+// Tarea de trama: avanza los planificadores del timer (desde la ISR TOVn)
+void PlanificadorServo::avanzarTrama(E_TIMMER_ASCIOADO timmer) {
+    for (uint8_t i = 0; i < numPlanificadores; i++) {
+        PlanificadorServo* p = planificadores[i];
+        if (p->canal->timmer != timmer) continue;
+
+        // Parado en destino: el OCR no cambia (movimientoAngulo directo sigue funcionando)
+        uint16_t ticks = p->avanzar();
+        if (!ticks) continue;
+
+        // Con dithering la posición Q8 completa: la rampa avanza por debajo del tick
+        if (p->servo->dithering) TramaTimmer::prepararOCRQ8(*p->canal, (uint32_t)p->posicion);
+        else                     TramaTimmer::prepararOCR(*p->canal, ticks);
+        p->servo->timmerServo.registroOCRData = ticks;
+    }
+}
@@ -1,15 +1,22 @@
 #include "ServoSG90/servo.h"
 
+ServoMotor* ServoMotor::servosReposo[MAX_SERVOS_REPOSO];
+uint8_t     ServoMotor::numServosReposo = 0;
 
 // Constructor
-ServoMotor::ServoMotor(const PinInfo& pin) 
-    : timmerServo(pin) // Inicializar el timmer asociado al pin
+ServoMotor::ServoMotor(const PinInfo& pin, const S_TABLA_TICKS* tabla, E_ARRANQUE_SERVO arranque, uint16_t ticksIniciales) 
+    : timmerServo(pin), // Inicializar el timmer asociado al pin
+      tablaTicks(tabla),
+      arranque(arranque)
 {
     standardMessage("Configurando servo motor SG90", __FILE__, __FUNCTION__, __DATE__, __TIME__);
 
     if (pinesNoDisponibles(pin)){printNopinDisponibleParaServo(pin); return;}
     
 
+    //Límites del pulso: perfil de calibración del canal (la EEPROM se lee la primera vez) o tabla del servo
+    if (!CalibracionServos::registrar(this)) aplicarCalibracion(S_CALIBRACION_SERVO{});
+
     mask = digitalPinToBitMask(pin.number);
     port = portOutputRegister(digitalPinToPort(pin.number));
     ddr  = portModeRegister(digitalPinToPort(pin.number));
@@ -25,8 +32,40 @@ ServoMotor::ServoMotor(const PinInfo& pin)
     }
 
 
-    //Constructor timmer y configuración
-    this-> ServoInicializado = this->timmerServo.initTimmer();
+    //Pulso inicial dentro del rango del servo
+    if (ticksIniciales < ticksMin) ticksIniciales = ticksMin;
+    if (ticksIniciales > ticksMax) ticksIniciales = ticksMax;
+    this->ticks = ticksIniciales;
+    this->ms = ticksIniciales / TICKS_POR_US;
+    this->angle = (anguloQ8DeTicks(ticksIniciales) + 128) >> 8;
+
+    //ULTIMA_POSICION: primer pulso en la posición guardada y rampa hasta ticksIniciales (sin ella, ESCALONADO)
+    uint16_t ticksArranque = ticksIniciales;
+    if (arranque == E_ARRANQUE_SERVO::ULTIMA_POSICION) {
+        uint16_t guardada = ArranqueServos::posicionGuardada(pin.number);
+        if (guardada == 0) {
+            arranque = E_ARRANQUE_SERVO::ESCALONADO;
+            this->arranque = arranque;
+        } else {
+            if (guardada < ticksMin) guardada = ticksMin;
+            if (guardada > ticksMax) guardada = ticksMax;
+            ticksArranque = guardada;
+        }
+    }
+
+    //Constructor timmer y configuración: INMEDIATO y ULTIMA_POSICION conectan la salida ya
+    bool conectarYa = (arranque == E_ARRANQUE_SERVO::INMEDIATO || arranque == E_ARRANQUE_SERVO::ULTIMA_POSICION);
+    this-> ServoInicializado = this->timmerServo.initTimmer(ticksArranque, conectarYa);
+    //Sin hueco para el turno o la rampa (tabla de tareas o de pendientes llena): como INMEDIATO
+    if (this->ServoInicializado && arranque == E_ARRANQUE_SERVO::ESCALONADO &&
+        !ArranqueServos::programarEscalonado(this->timmerServo)) {
+        this->timmerServo.conectarSalida();
+    }
+    if (this->ServoInicializado && ticksArranque != ticksIniciales &&
+        !ArranqueServos::programarRampa(this->timmerServo, ticksIniciales)) {
+        aplicarTicks(ticksIniciales);
+    }
+    this->reconectarAlEscribir = (arranque == E_ARRANQUE_SERVO::SALIDA_BAJA);
 
 
 
@@ -38,63 +77,298 @@ ServoMotor::ServoMotor(const PinInfo& pin)
 };
 
 bool ServoMotor::movimientoAngulo(uint8_t angulo) {
+    if (!this->ServoInicializado) return false;
     this->angle = angulo;
 
-    // Mapear el ángulo (0-180) a un valor OCR (ej. 1000-2000 para 1 µs - 2 µs)
-    this->ms = map(angulo, 0, 180, 544, 2400);
+    // Ángulo (0-180) → ticks desde la tabla en flash o la recta del perfil (sin map() ni división de 32 bits)
+    this->ticks = ticksDeAngulo(angulo);
+    this->ms = this->ticks / TICKS_POR_US;
     this->preEscalar = 8; //mejorar
-    this->ticks = this->ms * 2; // Con prescaler de 8 y tick de 0.5 µs
-
-    switch (this->timmerServo.pin.number) {
-    case  2: // OC3B
-         OCR3B = this->ticks; // Asignar el valor al registro OCR3B
-         this->timmerServo.registroOCRData = OCR3B;
-         break;       
-    case  3: // OC3C
-        OCR3C = this->ticks; // Asignar el valor al registro OCR3C
-        this->timmerServo.registroOCRData = OCR3C;
-        break; 
-    case  5: // OC3A
-        OCR3A = this->ticks; // Asignar el valor al registro OCR3A
-        this->timmerServo.registroOCRData = OCR3A;
-        break; 
-    case 6: // OC4A
-        OCR4A = this->ticks; // Asignar el valor al registro OCR4A
-        this->timmerServo.registroOCRData = OCR4A;
-        break; 
-    case 7: // OC4B
-        OCR4B = this->ticks; // Asignar el valor al registro OCR4B
-        this->timmerServo.registroOCRData = OCR4B;
-        break; 
-    case 8: // OC4C
-        OCR4C = this->ticks; // Asignar el valor al registro OCR4
-        this->timmerServo.registroOCRData = OCR4C;
-        break;
-    case 11: // OC1A
-        OCR1A = this->ticks; // Asignar el valor al registro OCR1A
-        this->timmerServo.registroOCRData = OCR1A;
-        break;
-    case 12: // OC1B
-        OCR1B = this->ticks; // Asignar el valor al registro OCR1
-        this->timmerServo.registroOCRData = OCR1B;
-        break;
-    case 4: // OC0B
-        OCR0B = this->ticks; // Asignar el valor al registro OCR0B
-        this->timmerServo.registroOCRData = OCR0B;
-        break;
-    case 13: // OC0A
-        OCR0A = this->ticks; // Asignar el valor al registro OCR0A
-        this->timmerServo.registroOCRData = OCR0A;
-        break;
-     case 9: // OC2B
-        OCR2B = this->ticks; // Asignar el valor al registro OCR2B
-        this->timmerServo.registroOCRData = OCR2B;
-        break; 
-    default:
-        break;
+
+    aplicarTicks(this->ticks);
+    return true;
+
+};
+
+bool ServoMotor::movimientoAnguloQ8(uint16_t anguloQ8) {
+    if (!this->ServoInicializado) return false;
+    this->angle = anguloQ8 >> 8;
+
+    // Con dithering la fracción de tick de la interpolación también llega al pulso (en media)
+    if (this->dithering) return escribirTicksQ8(ticksQ8DeAnguloQ8(anguloQ8));
+
+    // Interpolación entre las dos entradas de la tabla que rodean al ángulo (o recta del perfil)
+    this->ticks = ticksDeAnguloQ8(anguloQ8);
+    this->ms = this->ticks / TICKS_POR_US;
+
+    aplicarTicks(this->ticks);
+    return true;
+};
+
+bool ServoMotor::movimientoCentigrados(uint16_t centigrados) {
+    // Centésimas de grado → Q8 sin división, después el mismo camino interpolado
+    return movimientoAnguloQ8(centigradosAQ8(centigrados));
+};
+
+bool ServoMotor::escribirMicrosegundos(uint16_t us) {
+    // Tick de 0.5 µs: us × 2 (saturado para no desbordar 16 bits)
+    if (us > 0x7FFF) us = 0x7FFF;
+    return escribirTicks(us * TICKS_POR_US);
+};
+
+bool ServoMotor::escribirTicks(uint16_t ticks) {
+    if (!this->ServoInicializado) return false;
+
+    // Limitar al rango de pulso del servo
+    if (ticks < this->ticksMin) ticks = this->ticksMin;
+    if (ticks > this->ticksMax) ticks = this->ticksMax;
+    this->ticks = ticks;
+    this->ms = ticks / TICKS_POR_US;
+
+    aplicarTicks(ticks);
+    return true;
+};
+
+bool ServoMotor::escribirTicksQ8(uint32_t ticksQ8) {
+    if (!this->ServoInicializado) return false;
+
+    // Limitar al rango de pulso del servo
+    uint32_t minimo = (uint32_t)this->ticksMin << 8;
+    uint32_t maximo = (uint32_t)this->ticksMax << 8;
+    if (ticksQ8 < minimo) ticksQ8 = minimo;
+    if (ticksQ8 > maximo) ticksQ8 = maximo;
+    this->ticks = (ticksQ8 + 128) >> 8;
+    this->ms = this->ticks / TICKS_POR_US;
+
+    // Sin dithering el OCR solo admite ticks enteros: el más cercano
+    if (this->dithering) aplicarTicks(ticksQ8 >> 8, (uint8_t)ticksQ8);
+    else                 aplicarTicks(this->ticks);
+    return true;
+};
+
+bool ServoMotor::configurarDithering(bool activo) {
+    if (!this->ServoInicializado) return false;
+
+    if (!activo) {
+        this->dithering = false;
+        detenerDithering();
+        return true;
+    }
+
+    // El sigma-delta corre al confirmar la trama: el OCR debe pasar siempre por TramaTimmer
+    configurarModoActualizacion(E_MODO_ACTUALIZACION::TRAMA);
+    this->dithering = true;
+    return true;
+};
+
+void ServoMotor::detenerDithering() {
+    S_TRAMA_TIMMER& trama = TramaTimmer::tramas[static_cast<uint8_t>(this->timmerServo.canal.timmer)];
+    uint8_t k = TramaTimmer::indiceCanal(this->timmerServo.canal);
+
+    // Un valor pendiente ya es entero; si no, el OCR vuelve a la base (puede estar en base + 1)
+    ATOMIC_BLOCK(ATOMIC_RESTORESTATE) {
+        trama.conFraccion &= ~(1 << k);
+        if (trama.dithering & (1 << k)) {
+            trama.dithering &= ~(1 << k);
+            if (!(trama.pendientes & (1 << k))) _SFR_MEM16(this->timmerServo.canal.dirOCR) = trama.ticks[k];
+        }
+    }
+};
+
+uint32_t ServoMotor::ticksQ8DeAnguloQ8(uint16_t anguloQ8) const {
+    if (!this->calibrado) return anguloQ8ATicksQ8(this->tablaTicks, anguloQ8);
+
+    uint16_t minimoQ8 = (uint16_t)this->anguloMin << 8;
+    uint16_t maximoQ8 = (uint16_t)this->anguloMax << 8;
+    if (anguloQ8 < minimoQ8) anguloQ8 = minimoQ8;
+    if (anguloQ8 > maximoQ8) anguloQ8 = maximoQ8;
+
+    // Q8 × Q8 → Q16, se conservan 8 bits de fracción de tick
+    uint32_t delta = ((uint32_t)anguloQ8 * this->ticksPorGradoQ8 + 0x80UL) >> 8;
+    uint32_t cero = (uint32_t)this->ticksCero << 8;
+    return this->invertido ? cero - delta : cero + delta;
+};
+
+uint16_t ServoMotor::ticksDeAngulo(uint8_t angulo) const {
+    if (!this->calibrado) return anguloATicks(this->tablaTicks, angulo);
+    return ticksDeAnguloQ8((angulo > ANGULO_MAX_SERVO ? ANGULO_MAX_SERVO : angulo) << 8);
+};
+
+uint16_t ServoMotor::ticksDeAnguloQ8(uint16_t anguloQ8) const {
+    if (!this->calibrado) return anguloQ8ATicks(this->tablaTicks, anguloQ8);
+
+    // Límites blandos del perfil
+    uint16_t minimoQ8 = (uint16_t)this->anguloMin << 8;
+    uint16_t maximoQ8 = (uint16_t)this->anguloMax << 8;
+    if (anguloQ8 < minimoQ8) anguloQ8 = minimoQ8;
+    if (anguloQ8 > maximoQ8) anguloQ8 = maximoQ8;
+
+    // Q8 × Q8 → Q16: una multiplicación 16×16, redondeada
+    uint16_t delta = ((uint32_t)anguloQ8 * this->ticksPorGradoQ8 + 0x8000UL) >> 16;
+    return this->invertido ? this->ticksCero - delta : this->ticksCero + delta;
+};
+
+uint16_t ServoMotor::anguloQ8DeTicks(uint16_t ticks) const {
+    // Las tablas en flash son la misma recta redondeada: ticksCero y la pendiente valen para ambas
+    return ticksAAnguloQ8(ticks, this->ticksCero, this->ticksPorGradoQ8, this->invertido);
+};
+
+uint16_t ServoMotor::anguloQ8Actual() const {
+    uint16_t ticks;
+    ATOMIC_BLOCK(ATOMIC_RESTORESTATE) {
+        ticks = this->timmerServo.registroOCRData;
+    }
+    return anguloQ8DeTicks(ticks);
+};
+
+bool ServoMotor::aplicarCalibracion(const S_CALIBRACION_SERVO& perfil) {
+    bool activo = perfil.opciones & CALIBRACION_ACTIVA;
+    bool valido = activo && perfil.minUs < perfil.maxUs && (int16_t)perfil.minUs + perfil.trimUs > 0 &&
+                  perfil.anguloMin <= perfil.anguloMax && perfil.anguloMax <= ANGULO_MAX_SERVO;
+
+    // Pulsos a 0° y 180°: del perfil (con el trim) o de la tabla en flash
+    uint16_t t0, t180;
+    if (valido) {
+        t0   = (perfil.minUs + perfil.trimUs) * TICKS_POR_US;
+        t180 = (perfil.maxUs + perfil.trimUs) * TICKS_POR_US;
+    } else {
+        t0   = pgm_read_word(&this->tablaTicks->ticks[0]);
+        t180 = pgm_read_word(&this->tablaTicks->ticks[ANGULO_MAX_SERVO]);
+    }
+
+    this->calibrado       = valido;
+    this->invertido       = valido && (perfil.opciones & CALIBRACION_INVERTIDA);
+    this->ticksCero       = this->invertido ? t180 : t0;
+    this->ticksPorGradoQ8 = (((uint32_t)(t180 - t0) << 8) + ANGULO_MAX_SERVO / 2) / ANGULO_MAX_SERVO;
+    this->anguloMin       = valido ? perfil.anguloMin : 0;
+    this->anguloMax       = valido ? perfil.anguloMax : ANGULO_MAX_SERVO;
+
+    // Límites en ticks: los extremos del intervalo permitido (escrituras en µs/ticks, grupos, planificador)
+    uint16_t a = ticksDeAngulo(this->anguloMin);
+    uint16_t b = ticksDeAngulo(this->anguloMax);
+    this->ticksMin = (a < b) ? a : b;
+    this->ticksMax = (a < b) ? b : a;
+
+    return valido || !activo;
+};
+
+void ServoMotor::desconectar() {
+    if (!this->ServoInicializado) return;
+
+    // Una desconexión manual no la deshace ni un turno de arranque pendiente ni la siguiente escritura
+    ATOMIC_BLOCK(ATOMIC_RESTORESTATE) {
+        this->reconectarAlEscribir = false;
+    }
+    ArranqueServos::cancelar(this->timmerServo);
+    this->timmerServo.desconectarSalida();
+};
+
+bool ServoMotor::configurarReposo(uint16_t tramas) {
+    if (!this->ServoInicializado) return false;
+
+    bool registrado = false;
+    for (uint8_t i = 0; i < numServosReposo; i++) {
+        if (servosReposo[i] == this) { registrado = true; break; }
+    }
+    if (!registrado && numServosReposo >= MAX_SERVOS_REPOSO) return false;
+    if (!TramaTimmer::agregarTarea(vigilarReposo)) return false;
+
+    ATOMIC_BLOCK(ATOMIC_RESTORESTATE) {
+        this->tramasReposo    = tramas;
+        this->tramasSinCambio = 0;
+        this->ultimoOCR       = _SFR_MEM16(this->timmerServo.canal.dirOCR);
+        if (!registrado) servosReposo[numServosReposo++] = this;
     }
+    TramaTimmer::habilitar(this->timmerServo.canal);
     return true;
+};
+
+bool ServoMotor::conectar() {
+    if (!this->ServoInicializado) return false;
+    if (this->timmerServo.salidaConectada || ArranqueServos::pendiente(this->timmerServo)) return true;
 
+    // En la ISR TOVn: el cambio de COMnx cae tras BOTTOM y el primer pulso sale completo
+    return ArranqueServos::programar(this->timmerServo, 1);
+};
+
+bool ServoMotor::reconectarSiPendiente() {
+    // El movimiento nuevo manda sobre la rampa de arranque: sigue desde la consigna alcanzada
+    ArranqueServos::cancelarRampa(this->timmerServo);
+
+    // SALIDA_BAJA sin escribir o liberada por reposo; una desconexión manual deja el flag a false
+    if (!this->reconectarAlEscribir) return false;
+    return conectar();
+};
+
+void ServoMotor::configurarModoActualizacion(E_MODO_ACTUALIZACION modo) {
+    // Escrituras directas: confirmar() no debe seguir alternando el OCR
+    if (modo == E_MODO_ACTUALIZACION::DIRECTO && this->dithering && this->ServoInicializado) {
+        this->dithering = false;
+        detenerDithering();
+    }
+    this->modoActualizacion = modo;
+    if (modo == E_MODO_ACTUALIZACION::TRAMA && this->ServoInicializado) {
+        TramaTimmer::habilitar(this->timmerServo.canal);
+    }
+};
+
+void ServoMotor::aplicarTicks(uint16_t ticks, uint8_t fraccion) {
+    // Una escritura directa termina la rampa de arranque
+    ArranqueServos::cancelarRampa(this->timmerServo);
+
+    if (this->reconectarAlEscribir && !this->timmerServo.salidaConectada) {
+        // Salida en bajo: OCR directo y salida conectada en la siguiente trama (primer pulso completo)
+        escribirRegistro16Atomico(this->timmerServo.canal.dirOCR, ticks);
+        this->timmerServo.registroOCRData = ticks;
+        conectar();
+        if (fraccion == 0) return;     // Con fracción se deja además la consigna Q8 para el dithering
+    }
+
+    if (fraccion != 0) {
+        // Dithering: base y fracción, el sigma-delta alterna el OCR desde la siguiente trama
+        TramaTimmer::prepararOCRQ8(this->timmerServo.canal, ((uint32_t)ticks << 8) | fraccion);
+    } else if (this->modoActualizacion == E_MODO_ACTUALIZACION::TRAMA) {
+        // Confirmado por la ISR TOVn: todos los canales del timer cambian en la misma trama
+        TramaTimmer::prepararOCR(this->timmerServo.canal, ticks);
+    } else {
+        // Escritura en el OCRnx del canal (dirección del descriptor), protegida frente a ISRs
+        escribirRegistro16Atomico(this->timmerServo.canal.dirOCR, ticks);
+    }
+    this->timmerServo.registroOCRData = ticks;
+};
+
+void ServoMotor::vigilarReposo(E_TIMMER_ASCIOADO timmer) {
+    S_TRAMA_TIMMER& trama = TramaTimmer::tramas[static_cast<uint8_t>(timmer)];
+
+    for (uint8_t i = 0; i < numServosReposo; i++) {
+        ServoMotor* s = servosReposo[i];
+        Timmer& t = s->timmerServo;
+        if (s->tramasReposo == 0 || t.canal.timmer != timmer) continue;
+
+        // Cambio de consigna: OCR escrito desde la trama anterior o valor pendiente de confirmar
+        // (con dithering el OCR alterna entre tramas: se compara la base)
+        uint8_t k = TramaTimmer::indiceCanal(t.canal);
+        uint16_t ocr = (trama.dithering & (1 << k)) ? trama.ticks[k] : _SFR_MEM16(t.canal.dirOCR);
+        bool cambio = (ocr != s->ultimoOCR) || (trama.pendientes & (1 << k));
+        s->ultimoOCR = ocr;
+
+        if (cambio) {
+            s->tramasSinCambio = 0;
+            if (!t.salidaConectada && s->reconectarAlEscribir) {
+                // Reconexión transparente tras el reposo (interrupciones ya deshabilitadas)
+                t.conectarSalida();
+                s->reconectarAlEscribir = false;
+            }
+            continue;
+        }
+
+        if (!t.salidaConectada) continue;
+        if (++s->tramasSinCambio >= s->tramasReposo) {
+            t.desconectarSalida();
+            s->reconectarAlEscribir = true;
+            s->tramasSinCambio = 0;
+        }
+    }
 };
 
 bool ServoMotor::pinesNoDisponibles(const PinInfo& pin) {
@@ -0,0 +1,227 @@
+#include "ServoSG90/servo8Bits.h"
+#include "ServoSG90/gestorTimmers.h"
+
+S_ESTADO_8BITS   ServoMotor8Bits::estados[NUM_CANALES_8BITS];
+volatile uint8_t ServoMotor8Bits::cicloTimer2 = 0;
+
+// Índices fijos en TABLA_CANALES_8BITS usados por las ISR
+constexpr uint8_t CANAL_OC0B = 0;
+constexpr uint8_t CANAL_OC0A = 1;
+constexpr uint8_t CANAL_OC2B = 2;
+constexpr uint8_t CANAL_OC2A = 3;
+
+
+// Constructor
+ServoMotor8Bits::ServoMotor8Bits(const PinInfo& pin, const S_TABLA_TICKS* tabla)
+    : tablaTicks(tabla)
+{
+    this->canal = buscarCanal8Bits(pin.number);
+    if (this->canal == SIN_CANAL_8BITS) {
+        Serial.print(F("Pin sin canal de 8 bits para servo: "));
+        Serial.println(pin.number);
+        return;
+    }
+
+    S_CANAL_8BITS descriptor;
+    memcpy_P(&descriptor, &TABLA_CANALES_8BITS[this->canal], sizeof(S_CANAL_8BITS));
+
+    // Timer0 se comparte con el core sin cambiar su modo; Timer2 pasa a modo Normal (un solo dueño por canal)
+    bool esTimer2 = (descriptor.timmer == E_TIMMER_ASCIOADO::TIMMER2);
+    uint8_t indiceCanal = (descriptor.bitOCIE == (1 << OCIE0A)) ? 0 : 1;   // OCIEnA = bit 1, OCIEnB = bit 2
+    E_RESERVA_TIMMER reserva = GestorTimmers::reservar(descriptor.timmer,
+                                                       esTimer2 ? E_MODO_TIMMER::NORMAL_8BITS : E_MODO_TIMMER::CORE_MILLIS,
+                                                       0xFF, indiceCanal, pin.name);
+    if (reserva == E_RESERVA_TIMMER::CONFLICTO) {
+        Serial.print(F("Timer ocupado para servo de 8 bits en pin: "));
+        Serial.println(pin.number);
+        return;
+    }
+
+    //Límites del pulso tomados de la tabla del servo
+    ticksMin = pgm_read_word(&tablaTicks->ticks[0]);
+    ticksMax = pgm_read_word(&tablaTicks->ticks[ANGULO_MAX_SERVO]);
+
+    S_ESTADO_8BITS& e = estados[this->canal];
+    e.mask = digitalPinToBitMask(pin.number);
+    e.port = portOutputRegister(digitalPinToPort(pin.number));
+    volatile uint8_t* ddr = portModeRegister(digitalPinToPort(pin.number));
+
+    ATOMIC_BLOCK(ATOMIC_RESTORESTATE) {
+        *e.port &= ~e.mask;     // Pin a 0 y como salida
+        *ddr    |= e.mask;
+        e.pulso     = 0;
+        e.ciclosFin = 0;
+        e.ciclo     = 0;
+    }
+
+    if (esTimer2) {
+        // Salida OC2x desconectada: el pin lo manejan las ISR
+        ATOMIC_BLOCK(ATOMIC_RESTORESTATE) {
+            TCCR2A &= ~descriptor.mascaraCOM;
+        }
+        if (reserva == E_RESERVA_TIMMER::CONFIGURAR) iniciarTimer2();
+    } else {
+        // Timer0 conserva modo y prescaler del core: solo se desconecta OC0x y se activa la comparación
+        ATOMIC_BLOCK(ATOMIC_RESTORESTATE) {
+            TCCR0A &= ~descriptor.mascaraCOM;
+            _SFR_MEM8(descriptor.dirOCR) = INICIO_TIMER0;
+            TIFR0   = descriptor.bitOCIE;    // OCFnx ocupa la misma posición que OCIEnx
+            TIMSK0 |= descriptor.bitOCIE;
+        }
+    }
+
+    // Pulso inicial de 1.5 ms → 3000 ticks (como Timmer::initTimmer)
+    this->ServoInicializado = 1;
+    escribirTicks(TICKS_PULSO_INICIAL);
+}
+
+// Metodo para mover el servo a un angulo especifico
+bool ServoMotor8Bits::movimientoAngulo(uint8_t angulo) {
+    if (!this->ServoInicializado) return false;
+    this->angle = (angulo > ANGULO_MAX_SERVO) ? ANGULO_MAX_SERVO : angulo;
+    return escribirTicks(anguloATicks(this->tablaTicks, angulo));
+}
+
+// Metodo para escribir el pulso en ticks de 0.5 µs (limitado al rango del servo)
+bool ServoMotor8Bits::escribirTicks(uint16_t t) {
+    if (!this->ServoInicializado) return false;
+    if (t < ticksMin) t = ticksMin;
+    if (t > ticksMax) t = ticksMax;
+    this->ticks = t;
+
+    // Timer0 cuenta en ticks de 4 µs: redondeo a 8 ticks de 0.5 µs
+    uint16_t pulso = (this->canal <= CANAL_OC0A) ? (uint16_t)((t + 4) >> DESPLAZAMIENTO_TIMER0) : t;
+
+    // Se aplica en la siguiente subida; la trama en curso termina con el valor anterior
+    ATOMIC_BLOCK(ATOMIC_RESTORESTATE) {
+        estados[this->canal].pulso = pulso;
+    }
+    return true;
+}
+
+// Metodo para buscar el canal de 8 bits de un pin (SIN_CANAL_8BITS si no tiene)
+uint8_t ServoMotor8Bits::buscarCanal8Bits(uint8_t pin) {
+    for (uint8_t i = 0; i < NUM_CANALES_8BITS; i++) {
+        if (pgm_read_byte(&TABLA_CANALES_8BITS[i].pin) == pin) return i;
+    }
+    return SIN_CANAL_8BITS;
+}
+
+// Metodo para configurar Timer2 en modo Normal con prescaler 8 (una sola vez, primer dueño)
+void ServoMotor8Bits::iniciarTimer2() {
+    ATOMIC_BLOCK(ATOMIC_RESTORESTATE) {
+        // WGM22:WGM20 = 000 (Normal, TOP = 0xFF), CS22:CS20 = 010 (clk/8 → 0.5 µs)
+        TCCR2A &= ~((1 << WGM21) | (1 << WGM20));
+        TCCR2B  = (1 << CS21);
+        TCNT2   = 0;
+        cicloTimer2 = 0;
+
+        TIFR2   = (1 << TOV2);
+        TIMSK2 |= (1 << TOIE2);
+    }
+}
+
+// Desbordamiento de Timer2 (cada 128 µs): subidas al inicio de trama y preparación de bajadas
+void ServoMotor8Bits::atenderDesbordeTimer2() {
+    uint8_t ciclo = cicloTimer2 + 1;
+    if (ciclo >= CICLOS_TRAMA_TIMER2) ciclo = 0;
+    cicloTimer2 = ciclo;
+
+    if (ciclo == 0) {
+        for (uint8_t k = CANAL_OC2B; k <= CANAL_OC2A; k++) {
+            if (estados[k].pulso) *estados[k].port |= estados[k].mask;
+        }
+        // Fin del pulso referido al TCNT2 real de la subida: la latencia de la ISR no lo acorta
+        uint8_t inicio = TCNT2;
+        for (uint8_t k = CANAL_OC2B; k <= CANAL_OC2A; k++) {
+            S_ESTADO_8BITS& e = estados[k];
+            uint16_t fin = e.pulso ? (uint16_t)(e.pulso + inicio) : 0;
+            e.ciclosFin = fin >> 8;
+            e.restoFin  = fin & 0xFF;
+        }
+        return;
+    }
+
+    for (uint8_t k = CANAL_OC2B; k <= CANAL_OC2A; k++) {
+        S_ESTADO_8BITS& e = estados[k];
+        if (ciclo != e.ciclosFin) continue;
+
+        uint8_t bit = (k == CANAL_OC2A) ? (1 << OCIE2A) : (1 << OCIE2B);
+        if (e.restoFin < MARGEN_TIMER2_TICKS) {
+            // Resto corto: la comparación podría llegar antes de programarla
+            while (TCNT2 < e.restoFin) {}
+            *e.port &= ~e.mask;
+        } else {
+            if (k == CANAL_OC2A) OCR2A = e.restoFin; else OCR2B = e.restoFin;
+            TIFR2   = bit;
+            TIMSK2 |= bit;
+
+            // Desbordamiento atendido tarde (otra ISR con las interrupciones deshabilitadas): si TCNT2
+            // ya pasó el resto la comparación no llega en este ciclo y el pulso duraría 128 µs más
+            if (TCNT2 >= e.restoFin) {
+                *e.port &= ~e.mask;
+                TIMSK2 &= ~bit;
+                TIFR2   = bit;
+            }
+        }
+    }
+}
+
+// Comparación de Timer0 de un canal (cada 1.024 ms): subida, bajada y OCR del ciclo siguiente
+void ServoMotor8Bits::atenderComparacionTimer0(uint8_t canal, uint16_t dirOCR) {
+    S_ESTADO_8BITS& e = estados[canal];
+    uint8_t ciclo = e.ciclo;
+
+    if (ciclo == 0) {
+        if (e.ciclosFin) *e.port |= e.mask;
+    } else if (ciclo == e.ciclosFin) {
+        *e.port &= ~e.mask;
+    }
+
+    // OCR0x con doble buffer (se carga en BOTTOM): se programa la comparación del ciclo siguiente
+    uint8_t siguiente = ciclo + 1;
+    if (siguiente >= CICLOS_TRAMA_TIMER0) siguiente = 0;
+
+    uint8_t ocr = INICIO_TIMER0;
+    if (siguiente == 0) {
+        // Trama siguiente: subida en INICIO_TIMER0 o INICIO_TIMER0 + 128. La bajada debe caer en un
+        // ciclo posterior (un OCR por ciclo) y lejos de BOTTOM (esta ISR escribe el OCR antes de la carga)
+        uint16_t pulso = e.pulso;
+        uint16_t finMinimo = INICIO_TIMER0 + pulso;
+        uint8_t resto = finMinimo & 0xFF;
+        if (finMinimo < 0x100 || resto < MARGEN_TIMER0_TICKS || resto > (uint8_t)(0xFF - MARGEN_TIMER0_TICKS)) ocr += 128;
+
+        uint16_t fin = ocr + pulso;
+        e.ciclosFin = pulso ? (fin >> 8) : 0;
+        e.restoFin  = fin & 0xFF;
+    } else if (siguiente == e.ciclosFin) {
+        ocr = e.restoFin;
+    }
+    _SFR_MEM8(dirOCR) = ocr;
+    e.ciclo = siguiente;
+}
+
+
+ISR(TIMER2_OVF_vect) {
+    ServoMotor8Bits::atenderDesbordeTimer2();
+}
+
+ISR(TIMER2_COMPA_vect) {
+    S_ESTADO_8BITS& e = ServoMotor8Bits::estados[CANAL_OC2A];
+    *e.port &= ~e.mask;
+    TIMSK2 &= ~(1 << OCIE2A);
+}
+
+ISR(TIMER2_COMPB_vect) {
+    S_ESTADO_8BITS& e = ServoMotor8Bits::estados[CANAL_OC2B];
+    *e.port &= ~e.mask;
+    TIMSK2 &= ~(1 << OCIE2B);
+}
+
+ISR(TIMER0_COMPA_vect) {
+    ServoMotor8Bits::atenderComparacionTimer0(CANAL_OC0A, 0x47);   // OCR0A
+}
+
+ISR(TIMER0_COMPB_vect) {
+    ServoMotor8Bits::atenderComparacionTimer0(CANAL_OC0B, 0x48);   // OCR0B
+}
@@ -0,0 +1,82 @@
+#include "ServoSG90/servoGroup.h"
+
+
+// Metodo para añadir un servo inicializado al grupo (pasa a modo de actualizacion por trama)
+bool ServoGroup::agregar(ServoMotor& servo) {
+    if (this->numServos >= MAX_SERVOS_GRUPO) return false;
+    if (!servo.ServoInicializado) return false;
+
+    const S_CANAL_OC& canal = servo.timmerServo.canal;
+    uint8_t k = TramaTimmer::indiceCanal(canal);
+
+    S_MIEMBRO_GRUPO& m = this->miembros[this->numServos++];
+    m.servo    = &servo;
+    m.trama    = &TramaTimmer::tramas[static_cast<uint8_t>(canal.timmer)];
+    m.indice   = k;
+    m.bitCanal = (1 << k);
+
+    // Las escrituras individuales del servo también pasan por la trama
+    servo.configurarModoActualizacion(E_MODO_ACTUALIZACION::TRAMA);
+    return true;
+}
+
+// Metodo para escribir un vector de ticks (uno por servo, en orden de alta)
+bool ServoGroup::escribirTicks(const uint16_t* ticks, uint8_t n) {
+    if (n != this->numServos) return false;
+
+    uint16_t limitados[MAX_SERVOS_GRUPO];
+    for (uint8_t i = 0; i < n; i++) {
+        const ServoMotor* s = this->miembros[i].servo;
+        uint16_t t = ticks[i];
+        if (t < s->ticksMin) t = s->ticksMin;
+        if (t > s->ticksMax) t = s->ticksMax;
+        limitados[i] = t;
+    }
+
+    confirmar(limitados, n);
+    return true;
+}
+
+// Metodo para escribir un vector de angulos (uno por servo, en orden de alta)
+bool ServoGroup::movimientoAngulos(const uint8_t* angulos, uint8_t n) {
+    if (n != this->numServos) return false;
+
+    // Conversión con la tabla de cada servo fuera de la sección crítica
+    uint16_t ticks[MAX_SERVOS_GRUPO];
+    for (uint8_t i = 0; i < n; i++) {
+        ServoMotor* s = this->miembros[i].servo;
+        ticks[i] = s->ticksDeAngulo(angulos[i]);
+        s->angle = (angulos[i] > ANGULO_MAX_SERVO) ? ANGULO_MAX_SERVO : angulos[i];
+    }
+
+    confirmar(ticks, n);
+    return true;
+}
+
+// Metodo para preparar todos los valores en una sola seccion critica
+void ServoGroup::confirmar(const uint16_t* ticks, uint8_t n) {
+    // Antes de preparar: una rampa de arranque aún viva escribiría su paso en la ISR TOVn sobre el
+    // valor del grupo (una salida pendiente de escritura se conecta en la siguiente trama; una
+    // desconectada a mano sigue en bajo)
+    for (uint8_t i = 0; i < n; i++) {
+        this->miembros[i].servo->reconectarSiPendiente();
+    }
+
+    // Ninguna ISR TOVn puede ver el grupo a medias: o se aplican todos o ninguno en esta trama
+    ATOMIC_BLOCK(ATOMIC_RESTORESTATE) {
+        for (uint8_t i = 0; i < n; i++) {
+            S_MIEMBRO_GRUPO& m = this->miembros[i];
+            m.trama->ticks[m.indice] = ticks[i];
+            m.trama->conFraccion &= ~m.bitCanal;     // Valor entero: un prepararOCRQ8 anterior no deja dithering
+            m.trama->pendientes |= m.bitCanal;
+            m.servo->timmerServo.registroOCRData = ticks[i];
+        }
+    }
+
+    // Estado informativo de cada servo
+    for (uint8_t i = 0; i < n; i++) {
+        ServoMotor* s = this->miembros[i].servo;
+        s->ticks = ticks[i];
+        s->ms = ticks[i] / TICKS_POR_US;
+    }
+}
@@ -0,0 +1,197 @@
+#include "ServoSG90/servoMultiplex.h"
+
+constexpr uint8_t INICIO_BANCO = 0xFF;     // eventoActual: el siguiente evento es la subida del banco
+
+S_SALIDA_PIN     ServoMultiplex::salidas[MAX_SERVOS_MULTIPLEX];
+uint16_t         ServoMultiplex::ticks[MAX_SERVOS_MULTIPLEX];
+uint8_t          ServoMultiplex::numServos = 0;
+S_PLAN_BANCO     ServoMultiplex::planes[NUM_BANCOS_MULTIPLEX][2];
+volatile uint8_t ServoMultiplex::planActivo[NUM_BANCOS_MULTIPLEX];
+volatile uint8_t ServoMultiplex::planesPendientes = 0;
+uint8_t          ServoMultiplex::bancoActual = 0;
+uint8_t          ServoMultiplex::eventoActual = INICIO_BANCO;
+S_PLAN_BANCO*    ServoMultiplex::planEnCurso = &ServoMultiplex::planes[0][0];
+
+
+// Ticks que faltan hasta el instante t de la trama (negativo si ya pasó), teniendo en cuenta el
+// reinicio de TCNT5 en TOP. La trama es de 40000 ticks, no 65536: la resta se hace en 32 bits y
+// se pliega a ±media trama en los dos sentidos (una bajada en 39800 atendida con TCNT5 = 50 ya
+// pasó hace 250 ticks, no faltan 14000)
+static inline int16_t ticksHasta(uint16_t t) {
+    int32_t d = (int32_t)t - TCNT5;
+    if (d >  (int32_t)(TICKS_TRAMA_MULTIPLEX / 2)) d -= TICKS_TRAMA_MULTIPLEX;
+    if (d < -(int32_t)(TICKS_TRAMA_MULTIPLEX / 2)) d += TICKS_TRAMA_MULTIPLEX;
+    return (int16_t)d;
+}
+
+
+// Metodo para configurar Timer5 y arrancar la trama multiplexada (false si Timer5 está ocupado)
+bool ServoMultiplex::iniciar() {
+    // Canal B (OCR5B) en CTC: incompatible con servos hardware en Timer5
+    E_RESERVA_TIMMER reserva = GestorTimmers::reservar(E_TIMMER_ASCIOADO::TIMMER5, E_MODO_TIMMER::CTC_ICR,
+                                                       TICKS_TRAMA_MULTIPLEX - 1, 1, "ServoMultiplex");
+    if (reserva != E_RESERVA_TIMMER::CONFIGURAR) return false;
+
+    /*
+    Timer5 en modo 12: CTC con TOP = ICR5 (WGM53:WGM50 = 1100), prescaler 8 (tick 0.5 µs).
+    ICR5 = 39999 → trama de 40000 ticks = 20 ms. Las salidas OC5x quedan desconectadas
+    (COM5x = 00): los pines se manejan desde la ISR con escrituras en el PORT.
+    */
+    ATOMIC_BLOCK(ATOMIC_RESTORESTATE) {
+        TCCR5B = 0;
+        TCCR5A = 0;
+        TCNT5  = 0;
+        ICR5   = TICKS_TRAMA_MULTIPLEX - 1;
+        OCR5B  = 0;
+
+        bancoActual  = 0;
+        eventoActual = INICIO_BANCO;
+
+        TIFR5  = (1 << OCF5B);
+        TIMSK5 |= (1 << OCIE5B);
+        TCCR5B = (1 << WGM53) | (1 << WGM52) | (1 << CS51);
+    }
+    return true;
+}
+
+// Metodo para añadir un pin GPIO; devuelve el canal o SIN_CANAL_MULTIPLEX
+int8_t ServoMultiplex::agregar(const PinInfo& pin) {
+    if (numServos >= MAX_SERVOS_MULTIPLEX) return SIN_CANAL_MULTIPLEX;
+    if (!isValidGPIO(pin)) return SIN_CANAL_MULTIPLEX;
+
+    // Misma representación port/mask que ServoMotor
+    uint8_t mask = digitalPinToBitMask(pin.number);
+    volatile uint8_t* port = portOutputRegister(digitalPinToPort(pin.number));
+    volatile uint8_t* ddr  = portModeRegister(digitalPinToPort(pin.number));
+
+    ATOMIC_BLOCK(ATOMIC_RESTORESTATE) {
+        *port &= ~mask;     // Pin a 0 hasta la primera consigna
+        *ddr  |= mask;
+    }
+
+    uint8_t canal = numServos++;
+    salidas[canal].port = port;
+    salidas[canal].mask = mask;
+    ticks[canal] = 0;       // Sin pulso hasta la primera consigna
+    return canal;
+}
+
+// Metodo para escribir el pulso de un canal en ticks de 0.5 µs (limitado a la tabla SG90)
+bool ServoMultiplex::escribirTicks(uint8_t canal, uint16_t t) {
+    if (canal >= numServos) return false;
+
+    uint16_t tMin = pgm_read_word(&TABLA_TICKS_SG90->ticks[0]);
+    uint16_t tMax = pgm_read_word(&TABLA_TICKS_SG90->ticks[ANGULO_MAX_SERVO]);
+    if (t < tMin) t = tMin;
+    if (t > tMax) t = tMax;
+
+    if (ticks[canal] == t) return true;
+    ticks[canal] = t;
+    construirPlan(canal % NUM_BANCOS_MULTIPLEX);
+    return true;
+}
+
+// Metodo para mover un canal a un angulo (tabla SG90 en flash)
+bool ServoMultiplex::movimientoAngulo(uint8_t canal, uint8_t angulo) {
+    return escribirTicks(canal, anguloATicks(TABLA_TICKS_SG90, angulo));
+}
+
+// Metodo para reconstruir el plan inactivo de un banco y pedir su activacion
+void ServoMultiplex::construirPlan(uint8_t banco) {
+    uint8_t bit = (1 << banco);
+
+    // Con el bit de pendiente borrado la ISR no cambia de buffer mientras se escribe el inactivo
+    ATOMIC_BLOCK(ATOMIC_RESTORESTATE) {
+        planesPendientes &= ~bit;
+    }
+    S_PLAN_BANCO& plan = planes[banco][planActivo[banco] ^ 1];
+    plan.numSubidas = 0;
+    plan.numBajadas = 0;
+
+    for (uint8_t c = banco; c < numServos; c += NUM_BANCOS_MULTIPLEX) {
+        uint16_t t = ticks[c];
+        if (!t) continue;
+        const S_SALIDA_PIN& s = salidas[c];
+
+        // Subida: una sola escritura por puerto
+        uint8_t i = 0;
+        while (i < plan.numSubidas && plan.subidas[i].port != s.port) i++;
+        if (i == plan.numSubidas) {
+            plan.subidas[i].port = s.port;
+            plan.subidas[i].mask = 0;
+            plan.numSubidas++;
+        }
+        plan.subidas[i].mask |= s.mask;
+
+        // Bajada: mismo instante y puerto → se fusiona; si no, inserción ordenada
+        uint8_t j = 0;
+        while (j < plan.numBajadas && plan.bajadas[j].tiempo < t) j++;
+        if (j < plan.numBajadas && plan.bajadas[j].tiempo == t && plan.bajadas[j].port == s.port) {
+            plan.bajadas[j].mask |= s.mask;
+            continue;
+        }
+        for (uint8_t k = plan.numBajadas; k > j; k--) plan.bajadas[k] = plan.bajadas[k - 1];
+        plan.bajadas[j].tiempo = t;
+        plan.bajadas[j].port   = s.port;
+        plan.bajadas[j].mask   = s.mask;
+        plan.numBajadas++;
+    }
+
+    ATOMIC_BLOCK(ATOMIC_RESTORESTATE) {
+        planesPendientes |= bit;
+    }
+}
+
+// Atención de la comparación OCR5B (llamado desde TIMER5_COMPB_vect)
+void ServoMultiplex::atenderInterrupcion() {
+    for (;;) {
+        uint16_t base = bancoActual * TICKS_BANCO_MULTIPLEX;
+
+        if (eventoActual == INICIO_BANCO) {
+            // Activar el plan nuevo del banco, si lo hay, y subir todos sus pines
+            uint8_t bit = (1 << bancoActual);
+            if (planesPendientes & bit) {
+                planActivo[bancoActual] ^= 1;
+                planesPendientes &= ~bit;
+            }
+            planEnCurso = &planes[bancoActual][planActivo[bancoActual]];
+
+            for (uint8_t i = 0; i < planEnCurso->numSubidas; i++) {
+                *planEnCurso->subidas[i].port |= planEnCurso->subidas[i].mask;
+            }
+            eventoActual = 0;
+        } else {
+            // Bajada: espera corta (< MARGEN_AGRUPAR_TICKS) hasta su instante exacto
+            const S_EVENTO_BAJADA& ev = planEnCurso->bajadas[eventoActual];
+            uint16_t instante = base + ev.tiempo;
+            while (ticksHasta(instante) > 0) {}
+            *ev.port &= ~ev.mask;
+            eventoActual++;
+        }
+
+        // Siguiente evento: otra bajada del banco o la subida del banco siguiente
+        uint16_t siguiente;
+        if (eventoActual < planEnCurso->numBajadas) {
+            siguiente = base + planEnCurso->bajadas[eventoActual].tiempo;
+        } else {
+            if (++bancoActual == NUM_BANCOS_MULTIPLEX) bancoActual = 0;
+            eventoActual = INICIO_BANCO;
+            siguiente = bancoActual * TICKS_BANCO_MULTIPLEX;
+        }
+        OCR5B = siguiente;
+
+        // Evento lejano: salir. Cercano o vencido: atenderlo ahora para no perder la comparación
+        if (ticksHasta(siguiente) > MARGEN_AGRUPAR_TICKS) {
+            TIFR5 = (1 << OCF5B);
+            return;
+        }
+        if (eventoActual == INICIO_BANCO) {
+            while (ticksHasta(siguiente) > 0) {}
+        }
+    }
+}
+
+
+ISR(TIMER5_COMPB_vect) {
+    ServoMultiplex::atenderInterrupcion();
+}
@@ -0,0 +1,99 @@
+#include "ServoSG90/sincronizador.h"
+
+uint16_t SincronizadorTimmers::desfases[NUM_TIMMERS];
+
+
+// Metodo para fijar el desfase de un timer: ticks desde el arranque comun hasta su BOTTOM (0 = automatico)
+bool SincronizadorTimmers::configurarDesfase(E_TIMMER_ASCIOADO timmer, uint16_t ticks) {
+    uint8_t t = static_cast<uint8_t>(timmer);
+    if (t >= NUM_TIMMERS || DIR_BASE_TIMMER[t] == 0) return false;
+    desfases[t] = ticks;
+    return true;
+}
+
+// Mayor OCR de los canales conectados del timer (0 si no hay ninguno)
+uint16_t SincronizadorTimmers::comparacionMaxima(uint16_t base) {
+    uint8_t tccrA = _SFR_MEM8(base);
+    uint16_t maximo = 0;
+
+    // COMnA1, COMnB1 y COMnC1 son los bits 7, 5 y 3 de TCCRnA
+    for (uint8_t c = 0; c < NUM_CANALES_TIMMER; c++) {
+        if (!(tccrA & (0x80 >> (2 * c)))) continue;
+        uint16_t ocr;
+        ATOMIC_BLOCK(ATOMIC_RESTORESTATE) {
+            ocr = _SFR_MEM16(base + OFFSET_OCRA_TIMMER + 2 * c);
+        }
+        if (ocr > maximo) maximo = ocr;
+    }
+    return maximo;
+}
+
+// Metodo para arrancar a la vez los timers de servo con sus desfases (devuelve cuantos se sincronizaron)
+uint8_t SincronizadorTimmers::sincronizar() {
+    uint16_t bases[NUM_TIMMERS];
+    uint16_t maximos[NUM_TIMMERS];
+    uint16_t contadores[NUM_TIMMERS];
+    uint8_t  indices[NUM_TIMMERS];
+    uint8_t  n = 0;
+    uint16_t top = 0;
+
+    // Timers de servo (Fast PWM con TOP = ICRn) con el mismo TOP que el primero
+    for (uint8_t t = 0; t < NUM_TIMMERS; t++) {
+        uint16_t base = DIR_BASE_TIMMER[t];
+        if (base == 0) continue;
+        if (GestorTimmers::modo(static_cast<E_TIMMER_ASCIOADO>(t)) != E_MODO_TIMMER::FAST_PWM_ICR) continue;
+
+        uint16_t icr;
+        ATOMIC_BLOCK(ATOMIC_RESTORESTATE) {
+            icr = _SFR_MEM16(base + OFFSET_ICR_TIMMER);
+        }
+        if (n == 0) top = icr;
+        else if (icr != top) continue;
+
+        bases[n] = base;
+        indices[n] = t;
+        n++;
+    }
+    if (n == 0) return 0;
+
+    // Contador de arranque de cada timer: TCNTn = TOP − desfase, siempre por encima de sus OCR
+    for (uint8_t k = 0; k < n; k++) {
+        uint16_t maximo = comparacionMaxima(bases[k]);
+        if ((uint32_t)maximo + 2 * MARGEN_SINCRONIZACION >= top) return 0;   // Pulso de trama completa
+
+        uint32_t desfase = desfases[indices[k]];
+        if (desfase == 0) desfase = MARGEN_SINCRONIZACION + (uint32_t)k * top / n;
+        uint16_t limite = top - maximo - MARGEN_SINCRONIZACION;
+        if (desfase > limite) desfase = limite;
+
+        maximos[k] = maximo;
+        contadores[k] = top - (uint16_t)desfase;
+    }
+
+    // Espera a un instante sin pulsos en curso en ningún timer; la parada se hace sin interrupciones
+    uint32_t espera = TRAMAS_ESPERA_SINCRONIZACION * 1000000UL / Timmer::hzTramaServo;
+    uint32_t inicio = micros();
+    do {
+        bool sincronizado = false;
+        ATOMIC_BLOCK(ATOMIC_RESTORESTATE) {
+            bool fueraDePulso = true;
+            for (uint8_t k = 0; k < n && fueraDePulso; k++) {
+                uint16_t tcnt = _SFR_MEM16(bases[k] + OFFSET_TCNT_TIMMER);
+                fueraDePulso = (tcnt > maximos[k] + MARGEN_SINCRONIZACION) && (tcnt < top - MARGEN_SINCRONIZACION);
+            }
+
+            if (fueraDePulso) {
+                // TSM mantiene el prescaler común (Timer0/1/3/4/5) en reset mientras se cargan los contadores
+                GTCCR = (1 << TSM) | (1 << PSRSYNC);
+                for (uint8_t k = 0; k < n; k++) {
+                    _SFR_MEM16(bases[k] + OFFSET_TCNT_TIMMER) = contadores[k];
+                }
+                GTCCR = 0;
+                sincronizado = true;
+            }
+        }
+        if (sincronizado) return n;
+    } while ((uint32_t)(micros() - inicio) < espera);
+
+    return 0;
+}
@@ -0,0 +1,115 @@
+#include "ServoSG90/suavizado.h"
+
+// Curvas en Q16 (0-65535), 128 intervalos + extremo; índice = E_SUAVIZADO − 1 (1548 bytes de flash)
+const uint16_t TABLA_SUAVIZADO[NUM_TABLAS_SUAVIZADO][PASOS_TABLA_SUAVIZADO + 1] PROGMEM = {
+    {   // SUAVE
+            0,    12,    47,   106,   188,   292,   418,   567,   736,   926,  1137,  1369,
+         1620,  1891,  2180,  2489,  2816,  3161,  3523,  3903,  4300,  4713,  5142,  5587,
+         6048,  6523,  7013,  7518,  8036,  8568,  9112,  9670, 10240, 10822, 11415, 12020,
+        12636, 13262, 13898, 14544, 15200, 15864, 16537, 17219, 17908, 18604, 19308, 20019,
+        20736, 21459, 22187, 22921, 23660, 24403, 25150, 25901, 26656, 27413, 28173, 28935,
+        29700, 30465, 31232, 32000, 32768, 33535, 34303, 35070, 35835, 36600, 37362, 38122,
+        38879, 39634, 40385, 41132, 41875, 42614, 43348, 44076, 44799, 45516, 46227, 46931,
+        47627, 48316, 48998, 49671, 50335, 50991, 51637, 52273, 52899, 53515, 54120, 54713,
+        55295, 55865, 56423, 56967, 57499, 58017, 58522, 59012, 59487, 59948, 60393, 60822,
+        61235, 61632, 62012, 62374, 62719, 63046, 63355, 63644, 63915, 64166, 64398, 64609,
+        64799, 64968, 65117, 65243, 65347, 65429, 65488, 65523, 65535
+    },
+    {   // ENTRADA
+            0,     4,    16,    36,    64,   100,   144,   196,   256,   324,   400,   484,
+          576,   676,   784,   900,  1024,  1156,  1296,  1444,  1600,  1764,  1936,  2116,
+         2304,  2500,  2704,  2916,  3136,  3364,  3600,  3844,  4096,  4356,  4624,  4900,
+         5184,  5476,  5776,  6084,  6400,  6724,  7056,  7396,  7744,  8100,  8464,  8836,
+         9216,  9604, 10000, 10404, 10816, 11236, 11664, 12100, 12544, 12996, 13456, 13924,
+        14400, 14884, 15376, 15876, 16384, 16900, 17424, 17956, 18496, 19044, 19600, 20164,
+        20736, 21316, 21904, 22500, 23104, 23716, 24336, 24964, 25600, 26244, 26896, 27556,
+        28224, 28900, 29584, 30276, 30976, 31684, 32400, 33123, 33855, 34595, 35343, 36099,
+        36863, 37635, 38415, 39203, 39999, 40803, 41615, 42435, 43263, 44099, 44943, 45795,
+        46655, 47523, 48399, 49283, 50175, 51075, 51983, 52899, 53823, 54755, 55695, 56643,
+        57599, 58563, 59535, 60515, 61503, 62499, 63503, 64515, 65535
+    },
+    {   // SALIDA
+            0,  1020,  2032,  3036,  4032,  5020,  6000,  6972,  7936,  8892,  9840, 10780,
+        11712, 12636, 13552, 14460, 15360, 16252, 17136, 18012, 18880, 19740, 20592, 21436,
+        22272, 23100, 23920, 24732, 25536, 26332, 27120, 27900, 28672, 29436, 30192, 30940,
+        31680, 32412, 33135, 33851, 34559, 35259, 35951, 36635, 37311, 37979, 38639, 39291,
+        39935, 40571, 41199, 41819, 42431, 43035, 43631, 44219, 44799, 45371, 45935, 46491,
+        47039, 47579, 48111, 48635, 49151, 49659, 50159, 50651, 51135, 51611, 52079, 52539,
+        52991, 53435, 53871, 54299, 54719, 55131, 55535, 55931, 56319, 56699, 57071, 57435,
+        57791, 58139, 58479, 58811, 59135, 59451, 59759, 60059, 60351, 60635, 60911, 61179,
+        61439, 61691, 61935, 62171, 62399, 62619, 62831, 63035, 63231, 63419, 63599, 63771,
+        63935, 64091, 64239, 64379, 64511, 64635, 64751, 64859, 64959, 65051, 65135, 65211,
+        65279, 65339, 65391, 65435, 65471, 65499, 65519, 65531, 65535
+    },
+    {   // ENTRADA_SALIDA
+            0,     8,    32,    72,   128,   200,   288,   392,   512,   648,   800,   968,
+         1152,  1352,  1568,  1800,  2048,  2312,  2592,  2888,  3200,  3528,  3872,  4232,
+         4608,  5000,  5408,  5832,  6272,  6728,  7200,  7688,  8192,  8712,  9248,  9800,
+        10368, 10952, 11552, 12168, 12800, 13448, 14112, 14792, 15488, 16200, 16928, 17672,
+        18432, 19208, 20000, 20808, 21632, 22472, 23328, 24200, 25088, 25992, 26912, 27848,
+        28800, 29768, 30752, 31752, 32768, 33783, 34783, 35767, 36735, 37687, 38623, 39543,
+        40447, 41335, 42207, 43063, 43903, 44727, 45535, 46327, 47103, 47863, 48607, 49335,
+        50047, 50743, 51423, 52087, 52735, 53367, 53983, 54583, 55167, 55735, 56287, 56823,
+        57343, 57847, 58335, 58807, 59263, 59703, 60127, 60535, 60927, 61303, 61663, 62007,
+        62335, 62647, 62943, 63223, 63487, 63735, 63967, 64183, 64383, 64567, 64735, 64887,
+        65023, 65143, 65247, 65335, 65407, 65463, 65503, 65527, 65535
+    },
+    {   // CUBICA
+            0,     0,     1,     3,     8,    16,    27,    43,    64,    91,   125,   166,
+          216,   275,   343,   422,   512,   614,   729,   857,  1000,  1158,  1331,  1521,
+         1728,  1953,  2197,  2460,  2744,  3049,  3375,  3724,  4096,  4492,  4913,  5359,
+         5832,  6332,  6859,  7415,  8000,  8615,  9261,  9938, 10648, 11390, 12167, 12978,
+        13824, 14706, 15625, 16581, 17576, 18609, 19683, 20797, 21952, 23149, 24389, 25672,
+        27000, 28372, 29791, 31255, 32768, 34280, 35744, 37163, 38535, 39863, 41146, 42386,
+        43583, 44738, 45852, 46926, 47959, 48954, 49910, 50829, 51711, 52557, 53368, 54145,
+        54887, 55597, 56274, 56920, 57535, 58120, 58676, 59203, 59703, 60176, 60622, 61043,
+        61439, 61811, 62160, 62486, 62791, 63075, 63338, 63582, 63807, 64014, 64204, 64377,
+        64535, 64678, 64806, 64921, 65023, 65113, 65192, 65260, 65319, 65369, 65410, 65444,
+        65471, 65492, 65508, 65519, 65527, 65532, 65534, 65535, 65535
+    },
+    {   // SENO
+            0,    10,    39,    89,   158,   246,   355,   482,   630,   796,   982,  1187,
+         1411,  1654,  1915,  2196,  2494,  2811,  3146,  3499,  3869,  4257,  4662,  5084,
+         5522,  5977,  6448,  6935,  7438,  7956,  8488,  9036,  9597, 10173, 10762, 11365,
+        11980, 12608, 13248, 13900, 14563, 15237, 15922, 16616, 17321, 18035, 18758, 19489,
+        20228, 20975, 21728, 22489, 23256, 24028, 24806, 25588, 26375, 27166, 27960, 28756,
+        29556, 30357, 31160, 31963, 32767, 33572, 34375, 35178, 35979, 36779, 37575, 38369,
+        39160, 39947, 40729, 41507, 42279, 43046, 43807, 44560, 45307, 46046, 46777, 47500,
+        48214, 48919, 49613, 50298, 50972, 51635, 52287, 52927, 53555, 54170, 54773, 55362,
+        55938, 56499, 57047, 57579, 58097, 58600, 59087, 59558, 60013, 60451, 60873, 61278,
+        61666, 62036, 62389, 62724, 63041, 63339, 63620, 63881, 64124, 64348, 64553, 64739,
+        64905, 65053, 65180, 65289, 65377, 65446, 65496, 65525, 65535
+    }
+};
+
+
+// Rebote por tramos: 7.5625·(t − c)² + k. Las esquinas entre botes no se interpolan bien con
+// una tabla (error del 1.6 %), así que se evalúa directamente con una multiplicación de 32 bits
+static uint16_t rebote(uint16_t t) {
+    uint16_t centro, base;
+    if      (t < 23831) { centro = 0;     base = 0;     }     // 1/2.75
+    else if (t < 47663) { centro = 35747; base = 49151; }     // 2/2.75: 1.5/2.75, 0.75
+    else if (t < 59578) { centro = 53620; base = 61439; }     // 2.5/2.75: 2.25/2.75, 0.9375
+    else                { centro = 62557; base = 64511; }     // 2.625/2.75, 0.984375
+
+    int32_t  d  = (int32_t)t - centro;
+    uint32_t d2 = ((uint32_t)(d * d)) >> 16;
+    uint32_t v  = ((d2 * 121) >> 4) + base;                   // 7.5625 = 121/16
+    return (v > 0xFFFF) ? 0xFFFF : (uint16_t)v;
+}
+
+// Metodo para aplicar una curva a un progreso Q16 (0-65535)
+uint16_t Suavizado::aplicar(E_SUAVIZADO curva, uint16_t t) {
+    uint8_t id = static_cast<uint8_t>(curva);
+    if (curva == E_SUAVIZADO::REBOTE) return rebote(t);
+    if (id == 0 || id > NUM_TABLAS_SUAVIZADO) return t;
+
+    const uint16_t* tabla = TABLA_SUAVIZADO[id - 1];
+    uint8_t  indice   = t >> DESPLAZAMIENTO_SUAVIZADO;
+    uint16_t fraccion = t & ((1 << DESPLAZAMIENTO_SUAVIZADO) - 1);
+    uint16_t a = pgm_read_word(&tabla[indice]);
+    if (fraccion == 0) return a;
+
+    int32_t paso = (int32_t)pgm_read_word(&tabla[indice + 1]) - a;
+    return (uint16_t)(a + ((paso * fraccion) >> DESPLAZAMIENTO_SUAVIZADO));
+}
@@ -1,6 +1,12 @@
 #include "ServoSG90/timmer.h"
+#include "ServoSG90/gestorTimmers.h"
 
-bool Timmer::initTimmer() {
+uint16_t Timmer::hzTramaServo  = HZ_TRAMA_SERVO;
+uint16_t Timmer::icrTramaServo = ICR_TRAMA_SERVO;
+
+constexpr uint16_t TOP_MINIMO_TIMMER = 3;      // Resolución mínima de PWM (2 bits, datasheet)
+
+bool Timmer::initTimmer(uint16_t ticksIniciales, bool conectar) {
 /*
     Mapeo completo de timers, canales OC y pines en Arduino Mega 2560
     -----------------------------------------------------------------------------------------------
@@ -18,6 +24,9 @@ bool Timmer::initTimmer() {
     11          | OC1A     | Timer1         | PB5        | OCR1A        | ICR1         | DDRB (bit 5) | 16 bits    | Servo / PWM preciso
     12          | OC1B     | Timer1         | PB6        | OCR1B        | ICR1         | DDRB (bit 6) | 16 bits    | Servo / PWM preciso
     13          | OC0A     | Timer0         | PB7        | OCR0A        | ---          | DDRB (bit 7) | 8 bits     | PWM rápido (~976 Hz)
+    44          | OC5C     | Timer5         | PL5        | OCR5C        | ICR5         | DDRL (bit 5) | 16 bits    | Servo / PWM preciso
+    45          | OC5B     | Timer5         | PL4        | OCR5B        | ICR5         | DDRL (bit 4) | 16 bits    | Servo / PWM preciso
+    46          | OC5A     | Timer5         | PL3        | OCR5A        | ICR5         | DDRL (bit 3) | 16 bits    | Servo / PWM preciso
 
     Explicación de columnas:
     - Pin Arduino: número de pin digital en la placa Mega 2560.
@@ -40,514 +49,336 @@ bool Timmer::initTimmer() {
 */
 
 
-    switch (pin.number){
-        case 2: // OC3B → Timer3 canal B. Configuración del Timer3 para Fast PWM con ICR3 como TOP
-        case 3: // OC3C → Timer3 canal C. Configuración del Timer3 para Fast PWM con ICR3 como TOP
-        case 5: // OC3A → Timer3 canal A. Configuración del Timer3 para Fast PWM con ICR3 como TOP
-        /*
-        Tabla de combinaciones de WGM30–WGM33 para Timer3 (ATmega2560) Waveform Generation Mode (Modo de Generación de Ondas)
-        --------------------------------------------------------------
-        Estos 4 bits (WGM33, WGM32, WGM31, WGM30) configuran el modo de operación del Timer3.
-        El modo define cómo cuenta el timer y cómo genera la señal PWM o interrupciones.
-
-        WGM33 | WGM32 | WGM31 | WGM30 | Modo seleccionado                  | Descripción / Uso típico
-        --------------------------------------------------------------------------------------------
-        0       0       0       0    Normal                              Contador libre, desborda en 0xFFFF
-        0       1       0       0    CTC (TOP = OCRnA)                   Temporizador, reinicia al llegar a OCRnA
-        0       0       1       0    Phase Correct PWM (TOP = OCRnA)     PWM simétrico, periodo definido por OCRnA
-        0       1       1       0    Fast PWM (TOP = OCRnA)              PWM rápido, periodo definido por OCRnA
-        1       0       1       0    Phase Correct PWM (TOP = ICRn)      PWM simétrico, periodo definido por ICRn
-        1       1       0       0    CTC (TOP = ICRn)                    Temporizador, reinicia al llegar a ICRn
-        1       1       1       0    Fast PWM (TOP = ICRn)               PWM rápido, periodo definido por ICRn (ideal para servos)
-        0       0       0       1    Phase Correct PWM (TOP = 0xFF)      PWM simétrico de 8 bits
-        0       0       1       1    Phase Correct PWM (TOP = 0x1FF)     PWM simétrico de 9 bits
-        0       1       0       1    Phase Correct PWM (TOP = 0x3FF)     PWM simétrico de 10 bits
-        0       0       1       1    Fast PWM (TOP = 0xFF)               PWM rápido de 8 bits
-        0       1       1       1    Fast PWM (TOP = 0x1FF)              PWM rápido de 9 bits
-        1       0       0       1    Fast PWM (TOP = 0x3FF)              PWM rápido de 10 bits
-
-        Notas:
-        - Para servos se usa normalmente: WGM33=1, WGM32=1, WGM31=1, WGM30=0 → Fast PWM con TOP = ICRn.
-        - En ese modo, ICRn define el periodo (ej. 20 ms) y OCRnx define el ancho del pulso (ej. 1–2 ms).
-        - Los modos con TOP fijo (0xFF, 0x1FF, 0x3FF) son útiles para PWM rápido en LEDs o ventiladores.
-        - Los modos Phase Correct generan una señal más simétrica, pero con frecuencia más baja.
-        */
-
-        //Selección del canal OC basado en el pin
-        if     (pin.number == 2)this->canalOC = E_CANAL_OC::OC3B;
-        else if(pin.number == 3)this->canalOC = E_CANAL_OC::OC3C;
-        else if(pin.number == 5)this->canalOC = E_CANAL_OC::OC3A;
-
-        /*
-        Diferencia entre TCCRnA y TCCRnB:
-
-        - TCCRnA:
-            * Bits WGMn0 y WGMn1 → seleccionan parte del modo de generación de onda.
-            * Bits COMnx1 y COMnx0 → definen cómo se comporta la salida OCnx (PWM normal, invertido, toggle).
-            * En resumen: controla la "forma" de la señal.
-
-        - TCCRnB:
-            * Bits WGMn2 y WGMn3 → completan la selección del modo de operación.
-            * Bits CSn2, CSn1, CSn0 → seleccionan el prescaler (divisor de frecuencia del reloj).
-            * En resumen: controla la "velocidad" del conteo del timer.
-
-        Ejemplo:
-            TCCR3A = (1 << WGM31) | (1 << COM3B1);   // Configura modo PWM y salida OC3B
-            TCCR3B = (1 << WGM33) | (1 << WGM32) | (1 << CS31); // Configura Fast PWM con TOP=ICR3 y prescaler=8
-        */
-        
-        //Formato Fast PWM con ICR3 como TOP
-        TCCR3A &= ~((1 << WGM30) | (1 << WGM31));
-        TCCR3B &= ~((1 << WGM32) | (1 << WGM33));
-        //Formato prescaler: limpiar bits CS32, CS31, CS30 
-        TCCR3B &= ~((1 << CS30) | (1 << CS31) | (1 << CS32));
-
-        //Configurar modo Fast PWM con ICR3 como TOP
-        TCCR3A |= (1 << WGM31);
-        TCCR3B |= (1 << WGM33) | (1 << WGM32);
-        
-        
-        /*
-        Tabla de modos COMnx1:COMnx0 (Compare Output Mode)
-        --------------------------------------------------
-        Estos bits (COMnx1 y COMnx0) definen cómo se comporta la salida OCnx
-        (ejemplo: OC3B → pin 2 en Arduino Mega) cuando el contador del timer
-        alcanza el valor de comparación (OCRnx).
-
-        COMnx1 | COMnx0 | Modo de salida en OCnx                  | Descripción detallada / Uso típico
-        -----------------------------------------------------------------------------------------------
-        0        0     Desconectado                             El pin no cambia, salida desconectada del timer.
-                                                                Útil si solo quieres usar el timer para interrupciones.
-
-        0        1     Toggle                                   El pin cambia de estado (HIGH ↔ LOW) cada vez que
-                                                                el contador coincide con OCRnx. Útil para generar
-                                                                señales cuadradas o medir frecuencia.
-
-        1        0     Clear on Compare, Set at TOP             El pin se pone en LOW cuando el contador alcanza OCRnx
-                                                                y se pone en HIGH cuando el contador reinicia en TOP.
-                                                                Este es el modo típico para generar PWM normal.
-
-        1        1     Set on Compare, Clear at TOP             El pin se pone en HIGH cuando el contador alcanza OCRnx
-                                                                y se pone en LOW cuando el contador reinicia en TOP.
-                                                                Es el modo PWM invertido (la lógica se invierte).
-
-        Notas importantes:
-        - "TOP" depende del modo WGM seleccionado:
-            * En timers de 8 bits (Timer0, Timer2) → TOP = 0xFF (255).
-            * En timers de 16 bits (Timer1, Timer3, Timer4, Timer5) → TOP puede ser OCRnA o ICRn.
-        - El valor OCRnx define el instante de comparación → controla el ancho del pulso.
-        - Para PWM normal se usa COMnx1=1 y COMnx0=0.
-        - Para PWM invertido se usa COMnx1=1 y COMnx0=1.
-        - El modo Toggle (0,1) es útil para generar señales de prueba o medir frecuencia con un osciloscopio.
-        */
-
-
-        if (pin.number == 2){
-            //Formatear Compare Output Mode para OC3B (pin 2)
-            TCCR3A &= ~((1 << COM3B0) | (1 << COM3B1));
-            // Configurar modo Clear on Compare, Set at TOP para OC3B
-            TCCR3A |= (1 << COM3B1);
-            this->registroTCCRA = TCCR3A;
-        }else if(pin.number == 3){
-            //Formatear Compare Output Mode para OC3C (pin 3)
-            TCCR3A &= ~((1 << COM3C0) | (1 << COM3C1));
-            // Configurar modo Clear on Compare, Set at TOP para OC3C
-            TCCR3A |= (1 << COM3C1);
-            this->registroTCCRA = TCCR3A;
-        }else if(pin.number == 5){
-            //Formatear Compare Output Mode para OC3A (pin 5)
-            TCCR3A &= ~((1 << COM3A0) | (1 << COM3A1));
-            // Configurar modo Clear on Compare, Set at TOP para OC3A
-            TCCR3A |= (1 << COM3A1);
-            this->registroTCCRA = TCCR3A;
-        }
+    //Selección del canal OC basado en el pin (tabla en flash, sin switch por pin)
+    if (!buscarCanalOC(pin.number, this->canal)) return false; //Pin no compatible con timer
+
+    //Reserva del canal: el timer se configura una sola vez y solo se comparte con el mismo modo y TOP
+    E_RESERVA_TIMMER reserva = GestorTimmers::reservar(this->canal.timmer, E_MODO_TIMMER::FAST_PWM_ICR, icrTramaServo,
+                                                       TramaTimmer::indiceCanal(this->canal), pin.name);
+    if (reserva == E_RESERVA_TIMMER::CONFLICTO) return false; //Timer o canal ocupado
+    bool configurarTimer = (reserva == E_RESERVA_TIMMER::CONFIGURAR);
+
+    volatile uint8_t& tccrA = _SFR_MEM8(this->canal.dirTCCRA);
+    volatile uint8_t& tccrB = _SFR_MEM8(this->canal.dirTCCRB);
+
+    this->canalOC     = this->canal.canalOC;
+    this->registroOCR = this->canal.registroOCR;
+    this->registroICR = this->canal.registroICR;
+
+    /*
+    Tabla de combinaciones de WGM30–WGM33 para Timer1/3/4 (ATmega2560) Waveform Generation Mode (Modo de Generación de Ondas)
+    --------------------------------------------------------------
+    Estos 4 bits (WGM33, WGM32, WGM31, WGM30) configuran el modo de operación del Timer3.
+    El modo define cómo cuenta el timer y cómo genera la señal PWM o interrupciones.
+
+    WGM33 | WGM32 | WGM31 | WGM30 | Modo seleccionado                  | Descripción / Uso típico
+    --------------------------------------------------------------------------------------------
+    0       0       0       0    Normal                              Contador libre, desborda en 0xFFFF
+    0       1       0       0    CTC (TOP = OCRnA)                   Temporizador, reinicia al llegar a OCRnA
+    0       0       1       0    Phase Correct PWM (TOP = OCRnA)     PWM simétrico, periodo definido por OCRnA
+    0       1       1       0    Fast PWM (TOP = OCRnA)              PWM rápido, periodo definido por OCRnA
+    1       0       1       0    Phase Correct PWM (TOP = ICRn)      PWM simétrico, periodo definido por ICRn
+    1       1       0       0    CTC (TOP = ICRn)                    Temporizador, reinicia al llegar a ICRn
+    1       1       1       0    Fast PWM (TOP = ICRn)               PWM rápido, periodo definido por ICRn (ideal para servos)
+    0       0       0       1    Phase Correct PWM (TOP = 0xFF)      PWM simétrico de 8 bits
+    0       0       1       1    Phase Correct PWM (TOP = 0x1FF)     PWM simétrico de 9 bits
+    0       1       0       1    Phase Correct PWM (TOP = 0x3FF)     PWM simétrico de 10 bits
+    0       0       1       1    Fast PWM (TOP = 0xFF)               PWM rápido de 8 bits
+    0       1       1       1    Fast PWM (TOP = 0x1FF)              PWM rápido de 9 bits
+    1       0       0       1    Fast PWM (TOP = 0x3FF)              PWM rápido de 10 bits
 
-        /*
-        Tabla de selección de reloj (Clock Select) para Timer3 (ATmega2560)
-        ------------------------------------------------------------------
-        Los bits CS32, CS31 y CS30 definen la fuente de reloj y el prescaler del timer.
-        La combinación de estos bits determina la velocidad a la que el contador avanza.
-
-        CS32 | CS31 | CS30 | Fuente de reloj seleccionada
-        -------------------------------------------------
-        0     0     0    No clock (timer detenido)
-        0     0     1    clk/1   → sin prescaler (16 MHz → tick = 62.5 ns)
-        0     1     0    clk/8   → prescaler = 8 (2 MHz → tick = 0.5 µs)
-        0     1     1    clk/64  → prescaler = 64 (250 kHz → tick = 4 µs)
-        1     0     0    clk/256 → prescaler = 256 (62.5 kHz → tick = 16 µs)
-        1     0     1    clk/1024→ prescaler = 1024 (15.6 kHz → tick = 64 µs)
-        1     1     0    Fuente externa en pin Tn (flanco descendente)
-        1     1     1    Fuente externa en pin Tn (flanco ascendente)
-
-        Notas:
-        - (1 << CS31) activa el bit CS31 → combinación 010 → prescaler = 8.
-        - Con prescaler = 8, el reloj del timer pasa de 16 MHz a 2 MHz.
-        - Cada tick dura 0.5 µs, lo que permite generar periodos largos como 20 ms (ideal para servos).
-        - Ejemplo: ICR3 = 40000 → 40000 × 0.5 µs = 20 ms de periodo.
+    Notas:
+    - Para servos se usa normalmente: WGM33=1, WGM32=1, WGM31=1, WGM30=0 → Fast PWM con TOP = ICRn.
+    - En ese modo, ICRn define el periodo (ej. 20 ms) y OCRnx define el ancho del pulso (ej. 1–2 ms).
+    - Los modos con TOP fijo (0xFF, 0x1FF, 0x3FF) son útiles para PWM rápido en LEDs o ventiladores.
+    - Los modos Phase Correct generan una señal más simétrica, pero con frecuencia más baja.
     */
-        TCCR3B |= (1 << CS31); // Prescaler de 8
-        this->registroTCCRB = TCCR3B; 
-
-        // Periodo de 20 ms → 40000 ticks × 0.5 µs  
-        ICR3 = 40000; 
-        this->registroICR = E_REGISTRO_ICR::ICR_3;
-        this->registroICRData = ICR3;
-
-        // Pulso inicial de 1.5 ms → 3000 ticks 
-        if (pin.number == 2){
-            OCR3B = 3000;
-            this->registroOCR = E_REGISTRO_OCR::OCR_3B;
-            this->registroOCRData = OCR3B;
-        }else if(pin.number == 3){
-            OCR3C = 3000;
-            this->registroOCR = E_REGISTRO_OCR::OCR_3C;
-            this->registroOCRData = OCR3C;
-        }else if(pin.number == 5){
-            OCR3A = 3000;
-            this->registroOCR = E_REGISTRO_OCR::OCR_3A;
-            this->registroOCRData = OCR3A;
-        }
-        //Pin configurado ok
-        return true;
-    break;
-    
-    case 6: // OC4A → Timer4 canal B. Configuración del Timer4 para Fast PWM con ICR4 como TOP
-    case 7: // OC4C → Timer4 canal C. Configuración del Timer4 para Fast PWM con ICR4 como TOP
-    case 8: // OC4B → Timer4 canal A. Configuración del Timer4 para Fast PWM con ICR4 como TOP
-        /*
-        Tabla de combinaciones de WGM30–WGM33 para Timer3 (ATmega2560) Waveform Generation Mode (Modo de Generación de Ondas)
-        --------------------------------------------------------------
-        Estos 4 bits (WGM33, WGM32, WGM31, WGM30) configuran el modo de operación del Timer3.
-        El modo define cómo cuenta el timer y cómo genera la señal PWM o interrupciones.
-
-        WGM33 | WGM32 | WGM31 | WGM30 | Modo seleccionado                  | Descripción / Uso típico
-        --------------------------------------------------------------------------------------------
-        0       0       0       0    Normal                              Contador libre, desborda en 0xFFFF
-        0       1       0       0    CTC (TOP = OCRnA)                   Temporizador, reinicia al llegar a OCRnA
-        0       0       1       0    Phase Correct PWM (TOP = OCRnA)     PWM simétrico, periodo definido por OCRnA
-        0       1       1       0    Fast PWM (TOP = OCRnA)              PWM rápido, periodo definido por OCRnA
-        1       0       1       0    Phase Correct PWM (TOP = ICRn)      PWM simétrico, periodo definido por ICRn
-        1       1       0       0    CTC (TOP = ICRn)                    Temporizador, reinicia al llegar a ICRn
-        1       1       1       0    Fast PWM (TOP = ICRn)               PWM rápido, periodo definido por ICRn (ideal para servos)
-        0       0       0       1    Phase Correct PWM (TOP = 0xFF)      PWM simétrico de 8 bits
-        0       0       1       1    Phase Correct PWM (TOP = 0x1FF)     PWM simétrico de 9 bits
-        0       1       0       1    Phase Correct PWM (TOP = 0x3FF)     PWM simétrico de 10 bits
-        0       0       1       1    Fast PWM (TOP = 0xFF)               PWM rápido de 8 bits
-        0       1       1       1    Fast PWM (TOP = 0x1FF)              PWM rápido de 9 bits
-        1       0       0       1    Fast PWM (TOP = 0x3FF)              PWM rápido de 10 bits
-
-        Notas:
-        - Para servos se usa normalmente: WGM33=1, WGM32=1, WGM31=1, WGM30=0 → Fast PWM con TOP = ICRn.
-        - En ese modo, ICRn define el periodo (ej. 20 ms) y OCRnx define el ancho del pulso (ej. 1–2 ms).
-        - Los modos con TOP fijo (0xFF, 0x1FF, 0x3FF) son útiles para PWM rápido en LEDs o ventiladores.
-        - Los modos Phase Correct generan una señal más simétrica, pero con frecuencia más baja.
-        */
-
-        //Selección del canal OC basado en el pin
-        if     (pin.number == 6)this->canalOC = E_CANAL_OC::OC4A;
-        else if(pin.number == 7)this->canalOC = E_CANAL_OC::OC4B;
-        else if(pin.number == 8)this->canalOC = E_CANAL_OC::OC4C;
-
-        /*
-        Diferencia entre TCCRnA y TCCRnB:
-
-        - TCCRnA:
-            * Bits WGMn0 y WGMn1 → seleccionan parte del modo de generación de onda.
-            * Bits COMnx1 y COMnx0 → definen cómo se comporta la salida OCnx (PWM normal, invertido, toggle).
-            * En resumen: controla la "forma" de la señal.
-
-        - TCCRnB:
-            * Bits WGMn2 y WGMn3 → completan la selección del modo de operación.
-            * Bits CSn2, CSn1, CSn0 → seleccionan el prescaler (divisor de frecuencia del reloj).
-            * En resumen: controla la "velocidad" del conteo del timer.
-
-        Ejemplo:
-            TCCR3A = (1 << WGM31) | (1 << COM3B1);   // Configura modo PWM y salida OC3B
-            TCCR3B = (1 << WGM33) | (1 << WGM32) | (1 << CS31); // Configura Fast PWM con TOP=ICR3 y prescaler=8
-        */
-        
-        //Formato Fast PWM con ICR4 como TOP
-        TCCR4A &= ~((1 << WGM40) | (1 << WGM41));
-        TCCR4B &= ~((1 << WGM42) | (1 << WGM43));
-        //Formato prescaler: limpiar bits CS42, CS41, CS40 
-        TCCR4B &= ~((1 << CS40) | (1 << CS41) | (1 << CS42));
-
-        //Configurar modo Fast PWM con ICR4 como TOP
-        TCCR4A |= (1 << WGM41);
-        TCCR4B |= (1 << WGM43) | (1 << WGM42);
-        
-        
-        /*
-        Tabla de modos COMnx1:COMnx0 (Compare Output Mode)
-        --------------------------------------------------
-        Estos bits (COMnx1 y COMnx0) definen cómo se comporta la salida OCnx
-        (ejemplo: OC3B → pin 2 en Arduino Mega) cuando el contador del timer
-        alcanza el valor de comparación (OCRnx).
-
-        COMnx1 | COMnx0 | Modo de salida en OCnx                  | Descripción detallada / Uso típico
-        -----------------------------------------------------------------------------------------------
-        0        0     Desconectado                             El pin no cambia, salida desconectada del timer.
-                                                                Útil si solo quieres usar el timer para interrupciones.
-
-        0        1     Toggle                                   El pin cambia de estado (HIGH ↔ LOW) cada vez que
-                                                                el contador coincide con OCRnx. Útil para generar
-                                                                señales cuadradas o medir frecuencia.
-
-        1        0     Clear on Compare, Set at TOP             El pin se pone en LOW cuando el contador alcanza OCRnx
-                                                                y se pone en HIGH cuando el contador reinicia en TOP.
-                                                                Este es el modo típico para generar PWM normal.
-
-        1        1     Set on Compare, Clear at TOP             El pin se pone en HIGH cuando el contador alcanza OCRnx
-                                                                y se pone en LOW cuando el contador reinicia en TOP.
-                                                                Es el modo PWM invertido (la lógica se invierte).
-
-        Notas importantes:
-        - "TOP" depende del modo WGM seleccionado:
-            * En timers de 8 bits (Timer0, Timer2) → TOP = 0xFF (255).
-            * En timers de 16 bits (Timer1, Timer3, Timer4, Timer5) → TOP puede ser OCRnA o ICRn.
-        - El valor OCRnx define el instante de comparación → controla el ancho del pulso.
-        - Para PWM normal se usa COMnx1=1 y COMnx0=0.
-        - Para PWM invertido se usa COMnx1=1 y COMnx0=1.
-        - El modo Toggle (0,1) es útil para generar señales de prueba o medir frecuencia con un osciloscopio.
-        */
-
-
-        if (pin.number == 6){
-            //Formatear Compare Output Mode para OC4A (pin 6)
-            TCCR4A &= ~((1 << COM4A0) | (1 << COM4A1));
-            // Configurar modo Clear on Compare, Set at TOP para OC4A
-            TCCR4A |= (1 << COM4A1);
-            this->registroTCCRA = TCCR4A;
-        }else if(pin.number == 7){
-            //Formatear Compare Output Mode para OC4C (pin 3)
-            TCCR4A &= ~((1 << COM4B0) | (1 << COM4B1));
-            // Configurar modo Clear on Compare, Set at TOP para OC4C
-            TCCR4A |= (1 << COM4B1);
-            this->registroTCCRA = TCCR4A;
-        }else if(pin.number == 8){
-            //Formatear Compare Output Mode para OC4B (pin 5)
-            TCCR4A &= ~((1 << COM4C0) | (1 << COM4C1));
-            // Configurar modo Clear on Compare, Set at TOP para OC4B
-            TCCR4A |= (1 << COM4C1);
-            this->registroTCCRA = TCCR4A;
-        }
 
-        /*
-        Tabla de selección de reloj (Clock Select) para Timer3 (ATmega2560)
-        ------------------------------------------------------------------
-        Los bits CS32, CS31 y CS30 definen la fuente de reloj y el prescaler del timer.
-        La combinación de estos bits determina la velocidad a la que el contador avanza.
-
-        CS32 | CS31 | CS30 | Fuente de reloj seleccionada
-        -------------------------------------------------
-        0     0     0    No clock (timer detenido)
-        0     0     1    clk/1   → sin prescaler (16 MHz → tick = 62.5 ns)
-        0     1     0    clk/8   → prescaler = 8 (2 MHz → tick = 0.5 µs)
-        0     1     1    clk/64  → prescaler = 64 (250 kHz → tick = 4 µs)
-        1     0     0    clk/256 → prescaler = 256 (62.5 kHz → tick = 16 µs)
-        1     0     1    clk/1024→ prescaler = 1024 (15.6 kHz → tick = 64 µs)
-        1     1     0    Fuente externa en pin Tn (flanco descendente)
-        1     1     1    Fuente externa en pin Tn (flanco ascendente)
-
-        Notas:
-        - (1 << CS31) activa el bit CS31 → combinación 010 → prescaler = 8.
-        - Con prescaler = 8, el reloj del timer pasa de 16 MHz a 2 MHz.
-        - Cada tick dura 0.5 µs, lo que permite generar periodos largos como 20 ms (ideal para servos).
-        - Ejemplo: ICR3 = 40000 → 40000 × 0.5 µs = 20 ms de periodo.
+    /*
+    Diferencia entre TCCRnA y TCCRnB:
+
+    - TCCRnA:
+        * Bits WGMn0 y WGMn1 → seleccionan parte del modo de generación de onda.
+        * Bits COMnx1 y COMnx0 → definen cómo se comporta la salida OCnx (PWM normal, invertido, toggle).
+        * En resumen: controla la "forma" de la señal.
+
+    - TCCRnB:
+        * Bits WGMn2 y WGMn3 → completan la selección del modo de operación.
+        * Bits CSn2, CSn1, CSn0 → seleccionan el prescaler (divisor de frecuencia del reloj).
+        * En resumen: controla la "velocidad" del conteo del timer.
+
+    Ejemplo:
+        TCCR3A = (1 << WGM31) | (1 << COM3B1);   // Configura modo PWM y salida OC3B
+        TCCR3B = (1 << WGM33) | (1 << WGM32) | (1 << CS31); // Configura Fast PWM con TOP=ICR3 y prescaler=8
     */
-        TCCR4B |= (1 << CS31); // Prescaler de 8
-        this->registroTCCRB = TCCR4B; 
-
-        // Periodo de 20 ms → 40000 ticks × 0.5 µs  
-        ICR4 = 40000; 
-        this->registroICR = E_REGISTRO_ICR::ICR_4;
-        this->registroICRData = ICR4;
-
-        // Pulso inicial de 1.5 ms → 3000 ticks 
-        if (pin.number == 6){
-            OCR4A = 3000;
-            this->registroOCR = E_REGISTRO_OCR::OCR_4A;
-            this->registroOCRData = OCR4A;
-        }else if(pin.number == 7){
-            OCR4B = 3000;
-            this->registroOCR = E_REGISTRO_OCR::OCR_4B;
-            this->registroOCRData = OCR4B;
-        }else if(pin.number == 8){
-            OCR4C = 3000;
-            this->registroOCR = E_REGISTRO_OCR::OCR_4C;
-            this->registroOCRData = OCR4C;
-        }
 
-        //Pin configurado ok
+    if (configurarTimer) {
+        //Formato Fast PWM con ICRn como TOP
+        tccrA &= ~((1 << WGM10) | (1 << WGM11));
+        tccrB &= ~((1 << WGM12) | (1 << WGM13));
+        //Formato prescaler: limpiar bits CSn2, CSn1, CSn0
+        tccrB &= ~((1 << CS10) | (1 << CS11) | (1 << CS12));
+
+        //Configurar modo Fast PWM con ICRn como TOP
+        tccrA |= (1 << WGM11);
+        tccrB |= (1 << WGM13) | (1 << WGM12);
+    }
+
+    /*
+    Tabla de modos COMnx1:COMnx0 (Compare Output Mode)
+    --------------------------------------------------
+    Estos bits (COMnx1 y COMnx0) definen cómo se comporta la salida OCnx
+    (ejemplo: OC3B → pin 2 en Arduino Mega) cuando el contador del timer
+    alcanza el valor de comparación (OCRnx).
+
+    COMnx1 | COMnx0 | Modo de salida en OCnx                  | Descripción detallada / Uso típico
+    -----------------------------------------------------------------------------------------------
+    0        0     Desconectado                             El pin no cambia, salida desconectada del timer.
+                                                            Útil si solo quieres usar el timer para interrupciones.
+
+    0        1     Toggle                                   El pin cambia de estado (HIGH ↔ LOW) cada vez que
+                                                            el contador coincide con OCRnx. Útil para generar
+                                                            señales cuadradas o medir frecuencia.
+
+    1        0     Clear on Compare, Set at TOP             El pin se pone en LOW cuando el contador alcanza OCRnx
+                                                            y se pone en HIGH cuando el contador reinicia en TOP.
+                                                            Este es el modo típico para generar PWM normal.
+
+    1        1     Set on Compare, Clear at TOP             El pin se pone en HIGH cuando el contador alcanza OCRnx
+                                                            y se pone en LOW cuando el contador reinicia en TOP.
+                                                            Es el modo PWM invertido (la lógica se invierte).
+
+    Notas importantes:
+    - "TOP" depende del modo WGM seleccionado:
+        * En timers de 8 bits (Timer0, Timer2) → TOP = 0xFF (255).
+        * En timers de 16 bits (Timer1, Timer3, Timer4, Timer5) → TOP puede ser OCRnA o ICRn.
+    - El valor OCRnx define el instante de comparación → controla el ancho del pulso.
+    - Para PWM normal se usa COMnx1=1 y COMnx0=0.
+    - Para PWM invertido se usa COMnx1=1 y COMnx0=1.
+    - El modo Toggle (0,1) es útil para generar señales de prueba o medir frecuencia con un osciloscopio.
+    */
+
+    //El Compare Output Mode del canal (Clear on Compare, Set at TOP) se configura al final, con el
+    //OCR ya cargado; sin conectar, el pin queda en bajo hasta conectarSalida()
+
+    /*
+    Tabla de selección de reloj (Clock Select) para Timer3 (ATmega2560)
+    ------------------------------------------------------------------
+    Los bits CS32, CS31 y CS30 definen la fuente de reloj y el prescaler del timer.
+    La combinación de estos bits determina la velocidad a la que el contador avanza.
+
+    CS32 | CS31 | CS30 | Fuente de reloj seleccionada
+    -------------------------------------------------
+    0     0     0    No clock (timer detenido)
+    0     0     1    clk/1   → sin prescaler (16 MHz → tick = 62.5 ns)
+    0     1     0    clk/8   → prescaler = 8 (2 MHz → tick = 0.5 µs)
+    0     1     1    clk/64  → prescaler = 64 (250 kHz → tick = 4 µs)
+    1     0     0    clk/256 → prescaler = 256 (62.5 kHz → tick = 16 µs)
+    1     0     1    clk/1024→ prescaler = 1024 (15.6 kHz → tick = 64 µs)
+    1     1     0    Fuente externa en pin Tn (flanco descendente)
+    1     1     1    Fuente externa en pin Tn (flanco ascendente)
+
+    Notas:
+    - (1 << CS31) activa el bit CS31 → combinación 010 → prescaler = 8.
+    - Con prescaler = 8, el reloj del timer pasa de 16 MHz a 2 MHz.
+    - Cada tick dura 0.5 µs, lo que permite generar periodos largos como 20 ms (ideal para servos).
+    - Ejemplo: ICR3 = 40000 → 40000 × 0.5 µs = 20 ms de periodo.
+    */
+    if (configurarTimer) {
+        tccrB |= (1 << CS11); // Prescaler de 8
+
+        // Periodo de la trama: 40000 ticks × 0.5 µs = 20 ms por defecto (ver configurarTramaServo)
+        escribirRegistro16Atomico(this->canal.dirICR, icrTramaServo);
+    }
+    this->registroTCCRB = tccrB;
+    this->registroICRData = _SFR_MEM16(this->canal.dirICR);
+
+    // Pulso inicial (1.5 ms → 3000 ticks por defecto, o la última posición conocida del servo)
+    escribirRegistro16Atomico(this->canal.dirOCR, ticksIniciales);
+    this->registroOCRData = _SFR_MEM16(this->canal.dirOCR);
+
+    if (conectar) conectarSalida();
+    else          desconectarSalida();
+
+    //Pin configurado ok
+    this->isInitialized = true;
+    return true;
+}
+
+
+// Metodo para fijar la frecuencia de trama de los servos (50-400 Hz, antes de crear el primero)
+bool Timmer::configurarTramaServo(uint16_t hz) {
+    if (hz < HZ_TRAMA_SERVO_MIN || hz > HZ_TRAMA_SERVO_MAX) return false;
+
+    // Un timer de servo ya configurado no cambia de TOP (los canales que lo comparten lo esperan)
+    for (uint8_t t = 0; t < NUM_TIMMERS; t++) {
+        if (GestorTimmers::modo(static_cast<E_TIMMER_ASCIOADO>(t)) == E_MODO_TIMMER::FAST_PWM_ICR) return false;
+    }
+
+    hzTramaServo  = hz;
+    icrTramaServo = (F_CPU / PRESCALER_SERVO + hz / 2) / hz;
+    return true;
+}
+
+// Metodo para elegir el prescaler y el TOP de mayor resolucion para una frecuencia (false si no cabe)
+bool Timmer::seleccionarReloj(uint32_t frecuenciaHz, bool faseCorrecta, S_RELOJ_TIMMER& reloj) {
+    if (frecuenciaHz == 0) return false;
+
+    for (uint8_t i = 0; i < NUM_PRESCALERS_TIMMER; i++) {
+        // Cuentas por periodo redondeadas; en Phase Correct el contador sube y baja (2 · TOP)
+        uint32_t divisor = (uint32_t)PRESCALERS_TIMMER[i] * frecuenciaHz * (faseCorrecta ? 2 : 1);
+        uint32_t cuentas = (F_CPU + divisor / 2) / divisor;
+        uint32_t top = faseCorrecta ? cuentas : cuentas - 1;
+
+        if (cuentas == 0 || top < TOP_MINIMO_TIMMER) return false;     // Frecuencia demasiado alta
+        if (top > 0xFFFF) continue;                                    // Prescaler siguiente
+
+        reloj.prescaler = PRESCALERS_TIMMER[i];
+        reloj.bitsCS    = i + 1;
+        reloj.top       = top;
         return true;
-    break;
-
-    case 11: // OC1A → Timer1 canal A. Configuración del Timer1 para Fast PWM con ICR1 como TOP
-    case 12: // OC1B → Timer1 canal B. Configuración del Timer1 para Fast PWM con ICR1 como TOP
-        /*
-        Tabla de combinaciones de WGM30–WGM33 para Timer3 (ATmega2560) Waveform Generation Mode (Modo de Generación de Ondas)
-        --------------------------------------------------------------
-        Estos 4 bits (WGM33, WGM32, WGM31, WGM30) configuran el modo de operación del Timer3.
-        El modo define cómo cuenta el timer y cómo genera la señal PWM o interrupciones.
-
-        WGM33 | WGM32 | WGM31 | WGM30 | Modo seleccionado                  | Descripción / Uso típico
-        --------------------------------------------------------------------------------------------
-        0       0       0       0    Normal                              Contador libre, desborda en 0xFFFF
-        0       1       0       0    CTC (TOP = OCRnA)                   Temporizador, reinicia al llegar a OCRnA
-        0       0       1       0    Phase Correct PWM (TOP = OCRnA)     PWM simétrico, periodo definido por OCRnA
-        0       1       1       0    Fast PWM (TOP = OCRnA)              PWM rápido, periodo definido por OCRnA
-        1       0       1       0    Phase Correct PWM (TOP = ICRn)      PWM simétrico, periodo definido por ICRn
-        1       1       0       0    CTC (TOP = ICRn)                    Temporizador, reinicia al llegar a ICRn
-        1       1       1       0    Fast PWM (TOP = ICRn)               PWM rápido, periodo definido por ICRn (ideal para servos)
-        0       0       0       1    Phase Correct PWM (TOP = 0xFF)      PWM simétrico de 8 bits
-        0       0       1       1    Phase Correct PWM (TOP = 0x1FF)     PWM simétrico de 9 bits
-        0       1       0       1    Phase Correct PWM (TOP = 0x3FF)     PWM simétrico de 10 bits
-        0       0       1       1    Fast PWM (TOP = 0xFF)               PWM rápido de 8 bits
-        0       1       1       1    Fast PWM (TOP = 0x1FF)              PWM rápido de 9 bits
-        1       0       0       1    Fast PWM (TOP = 0x3FF)              PWM rápido de 10 bits
-
-        Notas:
-        - Para servos se usa normalmente: WGM33=1, WGM32=1, WGM31=1, WGM30=0 → Fast PWM con TOP = ICRn.
-        - En ese modo, ICRn define el periodo (ej. 20 ms) y OCRnx define el ancho del pulso (ej. 1–2 ms).
-        - Los modos con TOP fijo (0xFF, 0x1FF, 0x3FF) son útiles para PWM rápido en LEDs o ventiladores.
-        - Los modos Phase Correct generan una señal más simétrica, pero con frecuencia más baja.
-        */
-
-        //Selección del canal OC basado en el pin
-        if     (pin.number == 11)this->canalOC = E_CANAL_OC::OC1A;
-        else if(pin.number == 12)this->canalOC = E_CANAL_OC::OC1B;
-
-
-        /*
-        Diferencia entre TCCRnA y TCCRnB:
-
-        - TCCRnA:
-            * Bits WGMn0 y WGMn1 → seleccionan parte del modo de generación de onda.
-            * Bits COMnx1 y COMnx0 → definen cómo se comporta la salida OCnx (PWM normal, invertido, toggle).
-            * En resumen: controla la "forma" de la señal.
-
-        - TCCRnB:
-            * Bits WGMn2 y WGMn3 → completan la selección del modo de operación.
-            * Bits CSn2, CSn1, CSn0 → seleccionan el prescaler (divisor de frecuencia del reloj).
-            * En resumen: controla la "velocidad" del conteo del timer.
-
-        Ejemplo:
-            TCCR3A = (1 << WGM31) | (1 << COM3B1);   // Configura modo PWM y salida OC3B
-            TCCR3B = (1 << WGM33) | (1 << WGM32) | (1 << CS31); // Configura Fast PWM con TOP=ICR3 y prescaler=8
-        */
-        
-        //Formato Fast PWM con ICR1 como TOP
-        TCCR1A &= ~((1 << WGM10) | (1 << WGM11));
-        TCCR1B &= ~((1 << WGM12) | (1 << WGM13));
-        //Formato prescaler: limpiar bits CS42, CS41, CS40 
-        TCCR1B &= ~((1 << CS10) | (1 << CS11) | (1 << CS12));
-
-        //Configurar modo Fast PWM con ICR1 como TOP
-        TCCR1A |= (1 << WGM11);
-        TCCR1B |= (1 << WGM13) | (1 << WGM12);
-        
-        
-        /*
-        Tabla de modos COMnx1:COMnx0 (Compare Output Mode)
-        --------------------------------------------------
-        Estos bits (COMnx1 y COMnx0) definen cómo se comporta la salida OCnx
-        (ejemplo: OC3B → pin 2 en Arduino Mega) cuando el contador del timer
-        alcanza el valor de comparación (OCRnx).
-
-        COMnx1 | COMnx0 | Modo de salida en OCnx                  | Descripción detallada / Uso típico
-        -----------------------------------------------------------------------------------------------
-        0        0     Desconectado                             El pin no cambia, salida desconectada del timer.
-                                                                Útil si solo quieres usar el timer para interrupciones.
-
-        0        1     Toggle                                   El pin cambia de estado (HIGH ↔ LOW) cada vez que
-                                                                el contador coincide con OCRnx. Útil para generar
-                                                                señales cuadradas o medir frecuencia.
-
-        1        0     Clear on Compare, Set at TOP             El pin se pone en LOW cuando el contador alcanza OCRnx
-                                                                y se pone en HIGH cuando el contador reinicia en TOP.
-                                                                Este es el modo típico para generar PWM normal.
-
-        1        1     Set on Compare, Clear at TOP             El pin se pone en HIGH cuando el contador alcanza OCRnx
-                                                                y se pone en LOW cuando el contador reinicia en TOP.
-                                                                Es el modo PWM invertido (la lógica se invierte).
-
-        Notas importantes:
-        - "TOP" depende del modo WGM seleccionado:
-            * En timers de 8 bits (Timer0, Timer2) → TOP = 0xFF (255).
-            * En timers de 16 bits (Timer1, Timer3, Timer4, Timer5) → TOP puede ser OCRnA o ICRn.
-        - El valor OCRnx define el instante de comparación → controla el ancho del pulso.
-        - Para PWM normal se usa COMnx1=1 y COMnx0=0.
-        - Para PWM invertido se usa COMnx1=1 y COMnx0=1.
-        - El modo Toggle (0,1) es útil para generar señales de prueba o medir frecuencia con un osciloscopio.
-        */
-
-
-        if (pin.number == 11){
-            //Formatear Compare Output Mode para OC1A (pin 11)
-            TCCR1A &= ~((1 << COM1A0) | (1 << COM1A1));
-            // Configurar modo Clear on Compare, Set at TOP para OC1A
-            TCCR1A |= (1 << COM1A1);
-            this->registroTCCRA = TCCR1A;
-        }else if(pin.number == 12){
-            //Formatear Compare Output Mode para OC1B (pin 12)
-            TCCR1A &= ~((1 << COM1B0) | (1 << COM1B1));
-            // Configurar modo Clear on Compare, Set at TOP para OC1B
-            TCCR1A |= (1 << COM1B1);
-            this->registroTCCRA = TCCR1A;
+    }
+    return false;                                                      // Frecuencia demasiado baja
+}
+
+// Metodo para pasar una duracion en ms a tramas de servo (redondeo hacia arriba)
+uint16_t Timmer::msATramas(uint32_t ms) {
+    uint32_t tramas = (ms * hzTramaServo + 999) / 1000;
+    return (tramas > 0xFFFF) ? 0xFFFF : tramas;
+}
+
+// Metodo para iniciar el canal como PWM de uso general (frecuencia en Hz, modo y polaridad)
+bool Timmer::iniciarPWM(uint32_t frecuenciaHz, E_TIPO_PWM tipo, bool invertido) {
+    if (tipo == E_TIPO_PWM::SERVO) return false;   // La trama de servo se configura con initTimmer
+    bool fase = (tipo == E_TIPO_PWM::FASE_CORRECTA);
+
+    S_RELOJ_TIMMER reloj;
+    if (!seleccionarReloj(frecuenciaHz, fase, reloj)) return false;
+    if (!buscarCanalOC(pin.number, this->canal)) return false;
+
+    //Un canal ya iniciado suelta su reserva: si era el único del timer, el timer se reconfigura
+    uint8_t indice = TramaTimmer::indiceCanal(this->canal);
+    if (this->isInitialized) {
+        desconectarSalida();
+        GestorTimmers::liberar(this->canal.timmer, indice);
+        this->isInitialized = false;
+    }
+
+    E_MODO_TIMMER modo = fase ? E_MODO_TIMMER::PWM_FASE : E_MODO_TIMMER::PWM_RAPIDO;
+    E_RESERVA_TIMMER reserva = GestorTimmers::reservar(this->canal.timmer, modo, reloj.top, indice, pin.name, reloj.bitsCS);
+    if (reserva == E_RESERVA_TIMMER::CONFLICTO) return false;
+
+    this->canalOC     = this->canal.canalOC;
+    this->registroOCR = this->canal.registroOCR;
+    this->registroICR = this->canal.registroICR;
+    this->tipoPWM     = tipo;
+    this->invertido   = invertido;
+    this->reloj       = reloj;
+
+    //Pin de salida en su nivel de apagado (el que queda con la salida desconectada)
+    volatile uint8_t* port = portOutputRegister(digitalPinToPort(pin.number));
+    volatile uint8_t* ddr  = portModeRegister(digitalPinToPort(pin.number));
+    uint8_t mask = digitalPinToBitMask(pin.number);
+    ATOMIC_BLOCK(ATOMIC_RESTORESTATE) {
+        if (invertido) *port |= mask;
+        else           *port &= ~mask;
+        *ddr |= mask;
+    }
+
+    volatile uint8_t& tccrA = _SFR_MEM8(this->canal.dirTCCRA);
+    volatile uint8_t& tccrB = _SFR_MEM8(this->canal.dirTCCRB);
+    if (reserva == E_RESERVA_TIMMER::CONFIGURAR) {
+        ATOMIC_BLOCK(ATOMIC_RESTORESTATE) {
+            //Reloj parado mientras se cambian modo y TOP
+            tccrB &= ~((1 << CS10) | (1 << CS11) | (1 << CS12));
+            tccrA = (tccrA & ~((1 << WGM10) | (1 << WGM11))) | (1 << WGM11);
+            tccrB = (tccrB & ~((1 << WGM12) | (1 << WGM13))) | (1 << WGM13) | (fase ? 0 : (1 << WGM12));
+
+            _SFR_MEM16(this->canal.dirICR) = reloj.top;
+            _SFR_MEM16(this->canal.dirICR - 2) = 0;        // TCNTn (justo antes de ICRn)
+            tccrB |= reloj.bitsCS;
         }
+    }
+    this->registroTCCRB   = tccrB;
+    this->registroICRData = _SFR_MEM16(this->canal.dirICR);
 
-        /*
-        Tabla de selección de reloj (Clock Select) para Timer3 (ATmega2560)
-        ------------------------------------------------------------------
-        Los bits CS32, CS31 y CS30 definen la fuente de reloj y el prescaler del timer.
-        La combinación de estos bits determina la velocidad a la que el contador avanza.
-
-        CS32 | CS31 | CS30 | Fuente de reloj seleccionada
-        -------------------------------------------------
-        0     0     0    No clock (timer detenido)
-        0     0     1    clk/1   → sin prescaler (16 MHz → tick = 62.5 ns)
-        0     1     0    clk/8   → prescaler = 8 (2 MHz → tick = 0.5 µs)
-        0     1     1    clk/64  → prescaler = 64 (250 kHz → tick = 4 µs)
-        1     0     0    clk/256 → prescaler = 256 (62.5 kHz → tick = 16 µs)
-        1     0     1    clk/1024→ prescaler = 1024 (15.6 kHz → tick = 64 µs)
-        1     1     0    Fuente externa en pin Tn (flanco descendente)
-        1     1     1    Fuente externa en pin Tn (flanco ascendente)
-
-        Notas:
-        - (1 << CS31) activa el bit CS31 → combinación 010 → prescaler = 8.
-        - Con prescaler = 8, el reloj del timer pasa de 16 MHz a 2 MHz.
-        - Cada tick dura 0.5 µs, lo que permite generar periodos largos como 20 ms (ideal para servos).
-        - Ejemplo: ICR3 = 40000 → 40000 × 0.5 µs = 20 ms de periodo.
-    */
-        TCCR1B |= (1 << CS11); // Prescaler de 8
-        this->registroTCCRB = TCCR1B; 
-
-        // Periodo de 20 ms → 40000 ticks × 0.5 µs  
-        ICR1 = 40000; 
-        this->registroICR = E_REGISTRO_ICR::ICR_1;
-        this->registroICRData = ICR1;
-
-        // Pulso inicial de 1.5 ms → 3000 ticks 
-        if (pin.number == 11){
-            OCR1A = 3000;
-            this->registroOCR = E_REGISTRO_OCR::OCR_1A;
-            this->registroOCRData = OCR1A;
-        }else if(pin.number == 12){
-            OCR1B = 3000;
-            this->registroOCR = E_REGISTRO_OCR::OCR_1B;
-            this->registroOCRData = OCR1B;
+    //Arranca apagado
+    this->isInitialized = true;
+    return escribirCiclo(0);
+}
+
+// Metodo para fijar el ciclo de trabajo de 16 bits (0 = apagado, 65535 = encendido)
+bool Timmer::escribirCiclo(uint16_t ciclo) {
+    if (!this->isInitialized || this->tipoPWM == E_TIPO_PWM::SERVO) return false;
+
+    // 0..65535 → 0..65536 para que 65535 sea el ciclo completo
+    uint32_t escala = (uint32_t)ciclo + (ciclo >> 15);
+    uint16_t top = this->registroICRData;
+    uint16_t ocr;
+
+    if (this->tipoPWM == E_TIPO_PWM::FASE_CORRECTA) {
+        // Activo 2·OCR de 2·TOP ticks: OCR = 0 apagado limpio, OCR = TOP encendido
+        ocr = (escala * top + 0x8000UL) >> 16;
+    } else {
+        // Activo OCR + 1 de TOP + 1 ticks (65535 · 65536 + 2^15 cabe en 32 bits)
+        uint32_t activos = (escala > 0xFFFF) ? (uint32_t)top + 1 : (escala * ((uint32_t)top + 1) + 0x8000UL) >> 16;
+        if (activos == 0) {
+            // OCR = 0 daría un tick por periodo: salida desconectada, pin en su nivel de apagado
+            desconectarSalida();
+            this->registroOCRData = 0;
+            return true;
         }
+        ocr = activos - 1;
+    }
 
-        //Pin configurado ok
-        return true;
-        break;
+    escribirRegistro16Atomico(this->canal.dirOCR, ocr);
+    this->registroOCRData = ocr;
+    if (!this->salidaConectada) conectarSalida();
+    return true;
+}
+
+// Metodo para consultar la frecuencia real del PWM en Hz (0 si no es PWM de uso general)
+uint32_t Timmer::frecuenciaPWM() const {
+    if (!this->isInitialized || this->tipoPWM == E_TIPO_PWM::SERVO) return 0;
 
-    default:
-        break;
+    uint32_t divisor = (uint32_t)this->reloj.prescaler *
+                       (this->tipoPWM == E_TIPO_PWM::FASE_CORRECTA ? 2UL * this->reloj.top : this->reloj.top + 1UL);
+    return (F_CPU + divisor / 2) / divisor;
+}
+
+// Metodo para conectar la salida OCnx (COMnx1:COMnx0 = 10, o 11 si la salida es invertida)
+void Timmer::conectarSalida() {
+    volatile uint8_t& tccrA = _SFR_MEM8(this->canal.dirTCCRA);
+    uint8_t com = this->canal.mascaraCOM1 | (this->invertido ? this->canal.mascaraCOM0 : 0);
+
+    // TCCRnA es compartido por los tres canales y las tareas de trama también lo modifican
+    ATOMIC_BLOCK(ATOMIC_RESTORESTATE) {
+        tccrA = (tccrA & ~(this->canal.mascaraCOM1 | this->canal.mascaraCOM0)) | com;
+        this->registroTCCRA = tccrA;
+        this->salidaConectada = true;
     }
-    
-    //Pin no compatible con timer
-    return false; 
+}
+
+// Metodo para desconectar la salida OCnx (COMnx1:COMnx0 = 00, el pin queda con el valor de PORT)
+void Timmer::desconectarSalida() {
+    volatile uint8_t& tccrA = _SFR_MEM8(this->canal.dirTCCRA);
+
+    ATOMIC_BLOCK(ATOMIC_RESTORESTATE) {
+        tccrA &= ~(this->canal.mascaraCOM1 | this->canal.mascaraCOM0);
+        this->registroTCCRA = tccrA;
+        this->salidaConectada = false;
+    }
+}
+
+// Metodo para buscar el descriptor de canal OC de un pin (lectura desde flash)
+bool Timmer::buscarCanalOC(uint8_t pin, S_CANAL_OC& canal) {
+    if (pin >= NUM_PINES_CANAL_OC) return false;
+
+    uint8_t indice = pgm_read_byte(&TABLA_PIN_CANAL.indice[pin]);
+    if (indice == SIN_CANAL_OC) return false;
+
+    memcpy_P(&canal, &TABLA_CANALES_OC[indice], sizeof(S_CANAL_OC));
+    return true;
 }
 
 
@@ -713,10 +544,13 @@ void Timmer::printTimmerConfig() {
                       (this->registroOCR == E_REGISTRO_OCR::OCR_4C) ? "OCR4C" :
                       (this->registroOCR == E_REGISTRO_OCR::OCR_2B) ? "OCR2B" :
                       (this->registroOCR == E_REGISTRO_OCR::OCR_2A) ? "OCR2A" :
-                      (this->registroOCR == E_REGISTRO_OCR::OCR_1A) ? "OCR2A" :
+                      (this->registroOCR == E_REGISTRO_OCR::OCR_1A) ? "OCR1A" :
                       (this->registroOCR == E_REGISTRO_OCR::OCR_1B) ? "OCR1B" :
                       (this->registroOCR == E_REGISTRO_OCR::OCR_1C) ? "OCR1C" :
                       (this->registroOCR == E_REGISTRO_OCR::OCR_0A) ? "OCR0A" :
+                      (this->registroOCR == E_REGISTRO_OCR::OCR_5A) ? "OCR5A" :
+                      (this->registroOCR == E_REGISTRO_OCR::OCR_5B) ? "OCR5B" :
+                      (this->registroOCR == E_REGISTRO_OCR::OCR_5C) ? "OCR5C" :
                                                                     "Desconocido";                 
     Serial.println("Modo OCR seleccionado: " + modeOCR);
     Serial.println("Valor OCR configurado: " + String(this->registroOCRData));
@@ -0,0 +1,83 @@
+#include "ServoSG90/tramaTimmer.h"
+
+S_TRAMA_TIMMER TramaTimmer::tramas[NUM_TIMMERS];
+F_TAREA_TRAMA  TramaTimmer::tareas[MAX_TAREAS_TRAMA];
+uint8_t        TramaTimmer::numTareas = 0;
+
+
+// Metodo para habilitar la interrupcion TOVn del timer del canal
+void TramaTimmer::habilitar(const S_CANAL_OC& canal) {
+    ATOMIC_BLOCK(ATOMIC_RESTORESTATE) {
+        _SFR_MEM8(canal.dirTIMSK) |= (1 << TOIE1);   // TOIEn: bit 0 en TIMSK1/3/4/5
+    }
+}
+
+// Metodo para dejar preparado el valor de un canal (se aplica en la siguiente trama)
+void TramaTimmer::prepararOCR(const S_CANAL_OC& canal, uint16_t ticks) {
+    S_TRAMA_TIMMER& trama = tramas[static_cast<uint8_t>(canal.timmer)];
+    uint8_t k = indiceCanal(canal);
+
+    // La ISR no puede leer el valor a medias ni perder el bit de pendiente
+    ATOMIC_BLOCK(ATOMIC_RESTORESTATE) {
+        trama.ticks[k] = ticks;
+        trama.conFraccion &= ~(1 << k);
+        trama.pendientes |= (1 << k);
+    }
+}
+
+// Metodo para dejar preparado un valor en ticks Q8 (con fraccion: dithering desde la siguiente trama)
+void TramaTimmer::prepararOCRQ8(const S_CANAL_OC& canal, uint32_t ticksQ8) {
+    S_TRAMA_TIMMER& trama = tramas[static_cast<uint8_t>(canal.timmer)];
+    uint8_t k = indiceCanal(canal);
+    uint8_t fraccion = (uint8_t)ticksQ8;
+
+    ATOMIC_BLOCK(ATOMIC_RESTORESTATE) {
+        trama.ticks[k]    = ticksQ8 >> 8;
+        trama.fraccion[k] = fraccion;
+        if (fraccion) trama.conFraccion |= (1 << k);
+        else          trama.conFraccion &= ~(1 << k);
+        trama.pendientes |= (1 << k);
+    }
+}
+
+// Metodo para saber si un timer tiene valores sin confirmar
+bool TramaTimmer::hayPendientes(E_TIMMER_ASCIOADO timmer) {
+    return tramas[static_cast<uint8_t>(timmer)].pendientes != 0;
+}
+
+// Metodo para registrar una tarea de inicio de trama (una sola vez por funcion)
+bool TramaTimmer::agregarTarea(F_TAREA_TRAMA tarea) {
+    for (uint8_t i = 0; i < numTareas; i++) {
+        if (tareas[i] == tarea) return true;
+    }
+    if (numTareas >= MAX_TAREAS_TRAMA) return false;
+
+    // La ISR recorre la lista: la tarea se escribe antes de contarla
+    ATOMIC_BLOCK(ATOMIC_RESTORESTATE) {
+        tareas[numTareas] = tarea;
+        numTareas++;
+    }
+    return true;
+}
+
+
+// Inicio de trama (TOP) de cada timer de servo: tareas de trama y confirmar los OCRnx pendientes
+ISR(TIMER1_OVF_vect) {
+    TramaTimmer::ejecutarTareas(E_TIMMER_ASCIOADO::TIMMER1);
+    TramaTimmer::confirmar(TramaTimmer::tramas[static_cast<uint8_t>(E_TIMMER_ASCIOADO::TIMMER1)], 0x88);   // OCR1A
+}
+
+ISR(TIMER3_OVF_vect) {
+    TramaTimmer::ejecutarTareas(E_TIMMER_ASCIOADO::TIMMER3);
+    TramaTimmer::confirmar(TramaTimmer::tramas[static_cast<uint8_t>(E_TIMMER_ASCIOADO::TIMMER3)], 0x98);   // OCR3A
+}
+
+ISR(TIMER4_OVF_vect) {
+    TramaTimmer::ejecutarTareas(E_TIMMER_ASCIOADO::TIMMER4);
+    TramaTimmer::confirmar(TramaTimmer::tramas[static_cast<uint8_t>(E_TIMMER_ASCIOADO::TIMMER4)], 0xA8);   // OCR4A
+}
+
+ISR(TIMER5_OVF_vect) {
+    TramaTimmer::ejecutarTareas(E_TIMMER_ASCIOADO::TIMMER5);
+    TramaTimmer::confirmar(TramaTimmer::tramas[static_cast<uint8_t>(E_TIMMER_ASCIOADO::TIMMER5)], 0x128);  // OCR5A
+}
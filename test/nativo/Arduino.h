@@ -0,0 +1,20 @@
+#ifndef ARDUINO_NATIVO_H
+#define ARDUINO_NATIVO_H
+
+/*
+    Arduino.h mínimo para el entorno native (pio test -e native)
+    -----------------------------------------------------------------------------------------------
+    Solo lo que usan los módulos de cálculo puro (TrigFijo, Suavizado): tipos enteros y acceso a
+    PROGMEM. En el PC la flash es memoria normal, así que pgm_read_* es una lectura directa.
+*/
+
+#include <stdint.h>
+#include <stdlib.h>
+#include <math.h>
+
+#define PROGMEM
+#define pgm_read_byte(direccion)  (*(const uint8_t*)(direccion))
+#define pgm_read_word(direccion)  (*(const uint16_t*)(direccion))
+#define pgm_read_dword(direccion) (*(const uint32_t*)(direccion))
+
+#endif /* ARDUINO_NATIVO_H */
@@ -0,0 +1,129 @@
+#include <unity.h>
+#include <stdlib.h>
+#include "ServoSG90/tablaTicks.h"
+#include "ServoSG90/cinematicaPlano.h"
+
+/*
+    Ida y vuelta de la cinemática en el PC: pio test -e native
+
+    La pose de arranque de moverLineal() se obtiene al revés que un movimiento: ticks del servo →
+    ángulo Q8 (ticksAAnguloQ8) → articulación → cinemática directa. Resolver la inversa de ese
+    punto debe devolver los mismos ángulos y los mismos ticks: si no, el primer paso salta.
+*/
+
+// Límites de error medidos (ver cada test)
+static const int ERROR_TICKS_A_Q8    = 20;   // Q8 (0.08°): la tabla interpola por defecto (≈ 1.5 ticks)
+static const int ERROR_PLANO_BAM     = 48;   // BAM16 (0.26°): medido 41 con el codo a 20°/160° (acos pierde pendiente)
+static const int ERROR_CADENA_TICKS  = 6;    // Ticks de servo (0.3°) tras ticks → punto → ticks: medido 5
+
+static const uint16_t BRAZOS[][2] = { { 1280, 1280 }, { 1280, 960 }, { 960, 1600 } };   // Q4 mm
+
+void setUp() {}
+void tearDown() {}
+
+// Diferencia entre dos ángulos BAM16 por el camino corto
+static int32_t diferenciaBam(uint16_t a, uint16_t b) {
+    return (int16_t)(uint16_t)(a - b);
+}
+
+// Recta del SG90 como la calcula ServoMotor::aplicarCalibracion sin perfil
+static uint16_t ticksCeroSG90() { return pgm_read_word(&TABLA_TICKS_SG90->ticks[0]); }
+static uint16_t pendienteSG90() {
+    uint16_t t0 = ticksCeroSG90();
+    uint16_t t180 = pgm_read_word(&TABLA_TICKS_SG90->ticks[ANGULO_MAX_SERVO]);
+    return (((uint32_t)(t180 - t0) << 8) + ANGULO_MAX_SERVO / 2) / ANGULO_MAX_SERVO;
+}
+
+// Ticks → ángulo Q8: todos los ángulos Q8 de la tabla en flash y de una recta invertida
+void test_ticks_angulo_ida_y_vuelta() {
+    uint16_t t0 = ticksCeroSG90();
+    uint16_t pendiente = pendienteSG90();
+    for (uint32_t a = 0; a <= (uint32_t)ANGULO_MAX_SERVO << 8; a++) {
+        uint16_t t = anguloQ8ATicks(TABLA_TICKS_SG90, (uint16_t)a);
+        TEST_ASSERT_INT_WITHIN(ERROR_TICKS_A_Q8, (int)a, ticksAAnguloQ8(t, t0, pendiente, false));
+
+        // Perfil invertido: ticks = ticksCero − ángulo · pendiente (ServoMotor::ticksDeAnguloQ8)
+        uint16_t cero = 4800;
+        uint16_t ti = cero - (uint16_t)((a * pendiente + 0x8000UL) >> 16);
+        TEST_ASSERT_INT_WITHIN(ERROR_TICKS_A_Q8, (int)a, ticksAAnguloQ8(ti, cero, pendiente, true));
+    }
+
+    // Fuera de la recta: limitado a 0–180°
+    TEST_ASSERT_EQUAL_UINT16(0, ticksAAnguloQ8(t0 - 100, t0, pendiente, false));
+    TEST_ASSERT_EQUAL_UINT16((uint16_t)ANGULO_MAX_SERVO << 8, ticksAAnguloQ8(6000, t0, pendiente, false));
+    TEST_ASSERT_EQUAL_UINT16(0, ticksAAnguloQ8(3000, 3000, 0, false));
+}
+
+// Plano: directa → inversa devuelve hombro y codo en toda la rejilla alcanzable
+// (codo entre 20° y 160°: cerca del brazo estirado o plegado acos amplifica el redondeo)
+void test_plano_directa_inversa() {
+    for (const auto& brazo : BRAZOS) {
+        for (int32_t h = -90; h <= 180; h++) {
+            for (int32_t c = 20; c <= 160; c++) {
+                for (int signo = -1; signo <= 1; signo += 2) {
+                    uint16_t hombro = (uint16_t)((h * 65536L) / 360);
+                    uint16_t codo = (uint16_t)((signo * c * 65536L) / 360);
+                    int32_t r, z;
+                    CinematicaPlano::directa(brazo[0], brazo[1], hombro, codo, r, z);
+
+                    uint16_t h2, c2;
+                    TEST_ASSERT_TRUE(CinematicaPlano::inversa(brazo[0], brazo[1], signo < 0, r, z, h2, c2));
+                    TEST_ASSERT_INT_WITHIN(ERROR_PLANO_BAM, 0, diferenciaBam(h2, hombro));
+                    TEST_ASSERT_INT_WITHIN(ERROR_PLANO_BAM, 0, diferenciaBam(c2, codo));
+                }
+            }
+        }
+    }
+}
+
+// Fuera de alcance: más lejos que L1 + L2, más cerca que |L1 − L2| y el origen
+void test_plano_fuera_de_alcance() {
+    uint16_t h, c;
+    TEST_ASSERT_FALSE(CinematicaPlano::inversa(1280, 960, true, 2241, 0, h, c));
+    TEST_ASSERT_FALSE(CinematicaPlano::inversa(1280, 960, true, 0, 319, h, c));
+    TEST_ASSERT_FALSE(CinematicaPlano::inversa(1280, 960, true, 0, 0, h, c));
+}
+
+// Cadena completa de moverLineal(): ticks del servo → punto → ticks (hombro con cero en 0°, codo en 180°)
+// Hombro hasta 179°: a 180° el BAM16 0x8000 es también −180° y articulacionAServo lo limita al mínimo
+void test_cadena_ticks_punto_ticks() {
+    uint16_t t0 = ticksCeroSG90();
+    uint16_t pendiente = pendienteSG90();
+    const int32_t ceroCodoQ8 = (int32_t)ANGULO_MAX_SERVO << 8;
+
+    for (const auto& brazo : BRAZOS) {
+        for (uint8_t gh = 0; gh < ANGULO_MAX_SERVO; gh++) {
+            for (uint8_t gc = 20; gc <= 160; gc++) {
+                uint16_t th = anguloATicks(TABLA_TICKS_SG90, gh);
+                uint16_t tc = anguloATicks(TABLA_TICKS_SG90, gc);
+
+                // Ticks → grados Q8 → BAM16 (codo: servo − 180°, siempre negativo: codo arriba)
+                int32_t hQ8 = ticksAAnguloQ8(th, t0, pendiente, false);
+                int32_t cQ8 = (int32_t)ticksAAnguloQ8(tc, t0, pendiente, false) - ceroCodoQ8;
+                uint16_t hombro = (uint16_t)((hQ8 * 23302L + 16384L) >> 15);
+                uint16_t codo   = (uint16_t)((cQ8 * 23302L + 16384L) >> 15);
+
+                int32_t r, z;
+                CinematicaPlano::directa(brazo[0], brazo[1], hombro, codo, r, z);
+                uint16_t h2, c2;
+                TEST_ASSERT_TRUE(CinematicaPlano::inversa(brazo[0], brazo[1], true, r, z, h2, c2));
+
+                // BAM16 → grados Q8 → ticks, como CinematicaInversa::articulacionAServo
+                int32_t h2Q8 = ((int32_t)(int16_t)h2 * 45) / 32;
+                int32_t c2Q8 = ((int32_t)(int16_t)c2 * 45) / 32 + ceroCodoQ8;
+                if (h2Q8 < 0) h2Q8 = 0;
+                TEST_ASSERT_INT_WITHIN(ERROR_CADENA_TICKS, th, anguloQ8ATicks(TABLA_TICKS_SG90, (uint16_t)h2Q8));
+                TEST_ASSERT_INT_WITHIN(ERROR_CADENA_TICKS, tc, anguloQ8ATicks(TABLA_TICKS_SG90, (uint16_t)c2Q8));
+            }
+        }
+    }
+}
+
+int main() {
+    UNITY_BEGIN();
+    RUN_TEST(test_ticks_angulo_ida_y_vuelta);
+    RUN_TEST(test_plano_directa_inversa);
+    RUN_TEST(test_plano_fuera_de_alcance);
+    RUN_TEST(test_cadena_ticks_punto_ticks);
+    return UNITY_END();
+}
@@ -0,0 +1,77 @@
+#include <unity.h>
+#include <math.h>
+#include "ServoSG90/suavizado.h"
+
+/*
+    Tablas de Suavizado frente a las curvas analíticas (double) en el PC: pio test -e native
+*/
+
+// Error máximo admitido al interpolar: 0.02 % del recorrido (< 1 tick en 3712)
+static const long ERROR_MAXIMO_Q16 = 13;
+
+void setUp() {}
+void tearDown() {}
+
+// Curva de referencia (t en [0, 1])
+static double curvaReferencia(E_SUAVIZADO curva, double t) {
+    switch (curva) {
+        case E_SUAVIZADO::SUAVE:          return t * t * (3 - 2 * t);
+        case E_SUAVIZADO::ENTRADA:        return t * t;
+        case E_SUAVIZADO::SALIDA:         return 1 - (1 - t) * (1 - t);
+        case E_SUAVIZADO::ENTRADA_SALIDA: return (t < 0.5) ? 2 * t * t : 1 - pow(2 - 2 * t, 2) / 2;
+        case E_SUAVIZADO::CUBICA:         return (t < 0.5) ? 4 * t * t * t : 1 - pow(2 - 2 * t, 3) / 2;
+        case E_SUAVIZADO::SENO:           return (1 - cos(M_PI * t)) / 2;
+        case E_SUAVIZADO::REBOTE: {
+            const double n1 = 7.5625, d1 = 2.75;
+            if (t < 1 / d1)   return n1 * t * t;
+            if (t < 2 / d1)   { t -= 1.5 / d1;   return n1 * t * t + 0.75; }
+            if (t < 2.5 / d1) { t -= 2.25 / d1;  return n1 * t * t + 0.9375; }
+            t -= 2.625 / d1;
+            return n1 * t * t + 0.984375;
+        }
+        default:                          return t;
+    }
+}
+
+static long referenciaQ16(E_SUAVIZADO curva, uint32_t t) {
+    return lround(curvaReferencia(curva, t / 65536.0) * 65535.0);
+}
+
+// Las 129 entradas de cada tabla: valor de la curva redondeado (±1 por el redondeo al generarlas)
+void test_entradas_de_las_tablas() {
+    for (uint8_t id = 1; id <= NUM_TABLAS_SUAVIZADO; id++) {
+        E_SUAVIZADO curva = static_cast<E_SUAVIZADO>(id);
+        for (uint8_t i = 0; i <= PASOS_TABLA_SUAVIZADO; i++) {
+            double t = (double)i / PASOS_TABLA_SUAVIZADO;
+            long referencia = lround(curvaReferencia(curva, t) * 65535.0);
+            TEST_ASSERT_INT_WITHIN(1, referencia, TABLA_SUAVIZADO[id - 1][i]);
+        }
+        TEST_ASSERT_EQUAL_UINT16(0,      TABLA_SUAVIZADO[id - 1][0]);
+        TEST_ASSERT_EQUAL_UINT16(0xFFFF, TABLA_SUAVIZADO[id - 1][PASOS_TABLA_SUAVIZADO]);
+    }
+}
+
+// Todos los progresos Q16 de cada curva, incluida la interpolación y REBOTE por tramos
+void test_todas_las_curvas_interpoladas() {
+    for (uint8_t id = 1; id <= static_cast<uint8_t>(E_SUAVIZADO::REBOTE); id++) {
+        E_SUAVIZADO curva = static_cast<E_SUAVIZADO>(id);
+        for (uint32_t t = 0; t < 0x10000UL; t++) {
+            TEST_ASSERT_INT_WITHIN(ERROR_MAXIMO_Q16, referenciaQ16(curva, t), Suavizado::aplicar(curva, (uint16_t)t));
+        }
+    }
+}
+
+void test_lineal_y_fuera_de_rango() {
+    for (uint32_t t = 0; t < 0x10000UL; t += 257) {
+        TEST_ASSERT_EQUAL_UINT16(t, Suavizado::aplicar(E_SUAVIZADO::LINEAL, (uint16_t)t));
+        TEST_ASSERT_EQUAL_UINT16(t, Suavizado::aplicar(static_cast<E_SUAVIZADO>(0x7F), (uint16_t)t));
+    }
+}
+
+int main() {
+    UNITY_BEGIN();
+    RUN_TEST(test_entradas_de_las_tablas);
+    RUN_TEST(test_todas_las_curvas_interpoladas);
+    RUN_TEST(test_lineal_y_fuera_de_rango);
+    return UNITY_END();
+}
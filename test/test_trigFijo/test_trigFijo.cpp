@@ -0,0 +1,81 @@
+#include <unity.h>
+#include <math.h>
+#include "ServoSG90/trigFijo.h"
+
+/*
+    Precisión de TrigFijo frente a libm (double) en el PC: pio test -e native
+*/
+
+static const double BAM_A_RAD = 2.0 * M_PI / 65536.0;
+
+void setUp() {}
+void tearDown() {}
+
+// Diferencia entre dos ángulos BAM16 por el camino corto (la vuelta no cuenta como error)
+static int32_t diferenciaBam(uint16_t a, uint16_t b) {
+    return (int16_t)(uint16_t)(a - b);
+}
+
+static int16_t atanReferencia(int32_t y, int32_t x) {
+    return (int16_t)lround(atan2((double)y, (double)x) / BAM_A_RAD);
+}
+
+// Seno y coseno: los 65536 ángulos, ≤ 1 LSB Q15
+void test_seno_coseno_todos_los_angulos() {
+    for (uint32_t a = 0; a < 0x10000UL; a++) {
+        long s = lround(sin(a * BAM_A_RAD) * UNO_Q15);
+        long c = lround(cos(a * BAM_A_RAD) * UNO_Q15);
+        TEST_ASSERT_INT_WITHIN(1, s, TrigFijo::seno((uint16_t)a));
+        TEST_ASSERT_INT_WITHIN(1, c, TrigFijo::coseno((uint16_t)a));
+    }
+}
+
+// atan2: rejilla completa cerca del origen (pocos bits) y vectores grandes, ≤ 2 BAM
+void test_atan2_pequenos() {
+    for (int32_t y = -300; y <= 300; y++) {
+        for (int32_t x = -300; x <= 300; x++) {
+            if (x == 0 && y == 0) continue;
+            TEST_ASSERT_INT_WITHIN(2, 0, diferenciaBam(TrigFijo::atan2(y, x), (uint16_t)atanReferencia(y, x)));
+        }
+    }
+}
+
+void test_atan2_grandes() {
+    for (int32_t y = -1000000000L; y <= 1000000000L; y += 7654321L) {
+        for (int32_t x = -1000000000L; x <= 1000000000L; x += 7123457L) {
+            if (x == 0 && y == 0) continue;
+            TEST_ASSERT_INT_WITHIN(2, 0, diferenciaBam(TrigFijo::atan2(y, x), (uint16_t)atanReferencia(y, x)));
+        }
+    }
+    TEST_ASSERT_EQUAL_UINT16(0x2000, TrigFijo::atan2(100, 100));
+    TEST_ASSERT_EQUAL_UINT16(BAM_90, TrigFijo::atan2(1, 0));
+    TEST_ASSERT_EQUAL_UINT16(BAM_180, TrigFijo::atan2(0, -1));
+}
+
+// Raíz cuadrada exacta (por defecto) en todo el rango de 32 bits: cada cambio de resultado está
+// en un cuadrado perfecto, así que basta comprobar r² − 1, r² y (r + 1)² − 1 para cada r
+void test_raiz_cuadrada_exacta() {
+    for (uint32_t r = 1; r <= 0xFFFF; r++) {
+        uint32_t cuadrado = r * r;
+        TEST_ASSERT_EQUAL_UINT16(r - 1, TrigFijo::raizCuadrada(cuadrado - 1));
+        TEST_ASSERT_EQUAL_UINT16(r,     TrigFijo::raizCuadrada(cuadrado));
+        TEST_ASSERT_EQUAL_UINT16(r,     TrigFijo::raizCuadrada(cuadrado + 2 * r));
+    }
+    TEST_ASSERT_EQUAL_UINT16(0,      TrigFijo::raizCuadrada(0));
+    TEST_ASSERT_EQUAL_UINT16(0xFFFF, TrigFijo::raizCuadrada(0xFFFFFFFFUL));
+}
+
+void test_hipotenusa() {
+    TEST_ASSERT_EQUAL_UINT16(5,     TrigFijo::hipotenusa(3, -4));
+    TEST_ASSERT_EQUAL_UINT16(46340, TrigFijo::hipotenusa(-32768, -32768));
+}
+
+int main() {
+    UNITY_BEGIN();
+    RUN_TEST(test_seno_coseno_todos_los_angulos);
+    RUN_TEST(test_atan2_pequenos);
+    RUN_TEST(test_atan2_grandes);
+    RUN_TEST(test_raiz_cuadrada_exacta);
+    RUN_TEST(test_hipotenusa);
+    return UNITY_END();
+}